@@ -0,0 +1,216 @@
+/**
+ * Comparación entre las dos organizaciones de Persona: clase (medida_clases) y estructura
+ * (medida_estructura).
+ *
+ * POR QUÉ: Cada carpeta se mide con su propio programa, datos aleatorios distintos y su propio
+ *          monitor; sus números no se pueden comparar entre sí.
+ * CÓMO: Ambas variantes se enlazan en este ejecutable (cada una en su namespace) y reciben el
+ *       mismo conjunto generado con semilla. Por operación y variante: calentamiento,
+ *       repeticiones, mediana de tiempo, reservas y bytes de memoria dinámica y contadores de
+ *       caché (perf_event_open; los no disponibles se informan como "-"). Una suma de control
+ *       comprueba que las dos variantes hicieron el mismo trabajo.
+ * PARA QUÉ: Atribuir diferencias a la organización de los datos (encapsulamiento, getters,
+ *           copias) y no al entorno: ./comparacion [n] [semilla] [repeticiones] [csv]
+ */
+#include "variantes.h"
+#include "registro.h"
+#include "asignaciones.h"
+#include "contadores.h"
+#include <algorithm> // std::sort
+#include <chrono>
+#include <cstdlib>   // std::strtoull
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+const char* nombreOperacion(Operacion operacion) {
+    static const char* nombres[NUM_OPERACIONES] = {
+        "edadMasLongevaPais", "edadMasLongevaPaisRef",
+        "promedioEdadPais", "promedioEdadPaisRef",
+        "agruparCiudad", "agruparCiudadRef",
+        "agruparCalendario", "agruparCalendarioRef",
+        "declarantesRenta", "declarantesRentaRef",
+        "rankingRiquezaCiudad", "rankingRiquezaCiudadRef",
+        "leerCampos", "copiarCampos"
+    };
+    return operacion < NUM_OPERACIONES ? nombres[operacion] : "?";
+}
+
+// Parámetros de la comparación (modificables por línea de comandos)
+struct ConfiguracionComparacion {
+    size_t n = 200000;
+    uint64_t semilla = 1;
+    int calentamiento = 1;
+    int repeticiones = 5;
+    std::string csv = "comparacion.csv";
+};
+
+// Medición de una operación en una variante
+struct Medicion {
+    double mediana;          // ms
+    double reservas;         // Por ejecución
+    double bytes;            // Por ejecución
+    LecturaContadores contadores; // Media por ejecución
+    uint64_t control;
+};
+
+// Descarta la salida de las variantes Ref (sustituye a std::cout durante las mediciones)
+class SalidaNula : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+/**
+ * Mide una operación de una variante.
+ *
+ * POR QUÉ: Una sola muestra mezcla caché fría, páginas nuevas y ruido.
+ * CÓMO: Las ejecuciones de calentamiento no se miden; en cada repetición se toman tiempo,
+ *       reservas, bytes y contadores, y se guarda la mediana del tiempo.
+ * PARA QUÉ: Mismo procedimiento para las dos variantes.
+ */
+template <typename Conjunto>
+static Medicion medir(Conjunto& conjunto, uint64_t (*ejecutar)(Conjunto&, Operacion), Operacion operacion,
+                      const ConfiguracionComparacion& config, ContadoresRendimiento& contadores) {
+    Medicion medicion{};
+    for (int i = 0; i < config.calentamiento; ++i) {
+        medicion.control = ejecutar(conjunto, operacion);
+    }
+
+    std::vector<double> tiempos;
+    for (int i = 0; i < config.repeticiones; ++i) {
+        EstadoAsignaciones antes = leerAsignaciones();
+        contadores.iniciar();
+        auto inicio = std::chrono::steady_clock::now();
+
+        medicion.control = ejecutar(conjunto, operacion);
+
+        auto fin = std::chrono::steady_clock::now();
+        LecturaContadores lectura = contadores.detener();
+        EstadoAsignaciones despues = leerAsignaciones();
+
+        tiempos.push_back(std::chrono::duration<double, std::milli>(fin - inicio).count());
+        medicion.reservas += static_cast<double>(despues.asignaciones - antes.asignaciones);
+        medicion.bytes += static_cast<double>(despues.bytes - antes.bytes);
+        for (int e = 0; e < NUM_EVENTOS; ++e) {
+            medicion.contadores.valores[e] += lectura.valores[e];
+            medicion.contadores.disponible[e] = lectura.disponible[e];
+        }
+    }
+
+    std::sort(tiempos.begin(), tiempos.end());
+    medicion.mediana = tiempos[tiempos.size() / 2];
+    medicion.reservas /= config.repeticiones;
+    medicion.bytes /= config.repeticiones;
+    for (int e = 0; e < NUM_EVENTOS; ++e) {
+        medicion.contadores.valores[e] /= config.repeticiones;
+    }
+    return medicion;
+}
+
+// Valor de un contador para tabla y CSV ("-" si el sistema no lo ofrece)
+static std::string textoContador(const LecturaContadores& lectura, EventoContador evento) {
+    return lectura.disponible[evento] ? std::to_string(lectura.valores[evento]) : "-";
+}
+
+static bool leerArgumentos(int argc, char* argv[], ConfiguracionComparacion& config) {
+    if (argc > 5) {
+        std::cerr << "Uso: " << argv[0] << " [n] [semilla] [repeticiones] [csv]\n";
+        return false;
+    }
+    if (argc > 1) config.n = std::strtoull(argv[1], nullptr, 10);
+    if (argc > 2) config.semilla = std::strtoull(argv[2], nullptr, 10);
+    if (argc > 3) config.repeticiones = std::atoi(argv[3]);
+    if (argc > 4) config.csv = argv[4];
+    if (config.n == 0 || config.repeticiones <= 0) {
+        std::cerr << "n y repeticiones deben ser mayores que cero\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    activarSeguimientoAsignaciones();
+    ConfiguracionComparacion config;
+    if (!leerArgumentos(argc, argv, config)) {
+        return 1;
+    }
+
+    std::cout << "Generando " << config.n << " registros (semilla " << config.semilla << ")...\n";
+    std::vector<RegistroNeutral> registros = generarRegistros(config.n, config.semilla);
+    clases::Conjunto* conjuntoClases = clases::crearConjunto(registros);
+    estructura::Conjunto* conjuntoEstructura = estructura::crearConjunto(registros);
+    registros.clear();
+    registros.shrink_to_fit();
+
+    ContadoresRendimiento contadores;
+    if (!contadores.hardwareDisponible()) {
+        std::cout << "Aviso: contadores de hardware no disponibles; solo se informan los de software.\n";
+    }
+
+    std::ofstream csv(config.csv);
+    if (!csv) {
+        std::cerr << "No se pudo crear " << config.csv << "\n";
+        return 1;
+    }
+    csv << std::fixed;
+    csv << "Operacion,Variante,N,Repeticiones,Mediana(ms),Reservas,Bytes";
+    for (int e = 0; e < NUM_EVENTOS; ++e) {
+        csv << "," << ContadoresRendimiento::nombreEvento(static_cast<EventoContador>(e));
+    }
+    csv << ",Control\n";
+
+    std::cout << std::left << std::setw(26) << "Operacion" << std::setw(12) << "Variante"
+              << std::right << std::setw(12) << "Mediana(ms)" << std::setw(12) << "Reservas"
+              << std::setw(14) << "Bytes" << std::setw(14) << "FallosCache"
+              << std::setw(14) << "FallosPagina" << "\n";
+
+    bool coinciden = true;
+    SalidaNula nula;
+    for (int o = 0; o < NUM_OPERACIONES; ++o) {
+        Operacion operacion = static_cast<Operacion>(o);
+
+        std::streambuf* original = std::cout.rdbuf(&nula);
+        Medicion medClases = medir(*conjuntoClases, clases::ejecutar, operacion, config, contadores);
+        Medicion medEstructura = medir(*conjuntoEstructura, estructura::ejecutar, operacion, config, contadores);
+        std::cout.rdbuf(original);
+
+        const Medicion* mediciones[2] = {&medClases, &medEstructura};
+        const char* variantes[2] = {"clases", "estructura"};
+        for (int v = 0; v < 2; ++v) {
+            const Medicion& m = *mediciones[v];
+            std::cout << std::left << std::setw(26) << (v == 0 ? nombreOperacion(operacion) : "")
+                      << std::setw(12) << variantes[v] << std::right << std::fixed << std::setprecision(3)
+                      << std::setw(12) << m.mediana << std::setprecision(0)
+                      << std::setw(12) << m.reservas << std::setw(14) << m.bytes
+                      << std::setw(14) << textoContador(m.contadores, FALLOS_CACHE)
+                      << std::setw(14) << textoContador(m.contadores, FALLOS_PAGINA) << "\n";
+
+            csv << nombreOperacion(operacion) << "," << variantes[v] << "," << config.n << ","
+                << config.repeticiones << "," << std::setprecision(4) << m.mediana << ","
+                << std::setprecision(0) << m.reservas << "," << m.bytes;
+            for (int e = 0; e < NUM_EVENTOS; ++e) {
+                csv << "," << textoContador(m.contadores, static_cast<EventoContador>(e));
+            }
+            csv << "," << m.control << "\n";
+        }
+
+        if (medClases.control != medEstructura.control) {
+            std::cerr << "Diferencia en " << nombreOperacion(operacion) << ": " << medClases.control
+                      << " (clases) frente a " << medEstructura.control << " (estructura)\n";
+            coinciden = false;
+        }
+    }
+
+    clases::liberarConjunto(conjuntoClases);
+    estructura::liberarConjunto(conjuntoEstructura);
+
+    std::cout << "\nResultados guardados en " << config.csv << "\n";
+    if (!coinciden) {
+        std::cerr << "Las variantes no produjeron los mismos resultados\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "registro.h"
+#include "aleatorio.h"
+
+// Mismas listas que los generadores de medida_clases y medida_estructura
+static const std::vector<std::string> nombresFemeninos = {
+    "María", "Luisa", "Carmen", "Ana", "Sofía", "Isabel", "Laura", "Andrea", "Paula", "Valentina",
+    "Camila", "Daniela", "Carolina", "Fernanda", "Gabriela", "Patricia", "Claudia", "Diana", "Lucía", "Ximena"
+};
+
+static const std::vector<std::string> nombresMasculinos = {
+    "Juan", "Carlos", "José", "James", "Andrés", "Miguel", "Luis", "Pedro", "Alejandro", "Ricardo",
+    "Felipe", "David", "Jorge", "Santiago", "Daniel", "Fernando", "Diego", "Rafael", "Martín", "Óscar",
+    "Edison", "Nestor", "Gertridis"
+};
+
+static const std::vector<std::string> apellidos = {
+    "Gómez", "Rodríguez", "Martínez", "López", "García", "Pérez", "González", "Sánchez", "Ramírez", "Torres",
+    "Díaz", "Vargas", "Castro", "Ruiz", "Álvarez", "Romero", "Suárez", "Rojas", "Moreno", "Muñoz", "Valencia",
+};
+
+static const std::vector<std::string> ciudadesColombia = {
+    "Bogotá", "Medellín", "Cali", "Barranquilla", "Cartagena", "Bucaramanga", "Pereira", "Santa Marta", "Cúcuta", "Ibagué",
+    "Manizales", "Pasto", "Neiva", "Villavicencio", "Armenia", "Sincelejo", "Valledupar", "Montería", "Popayán", "Tunja"
+};
+
+std::vector<RegistroNeutral> generarRegistros(size_t n, uint64_t semilla) {
+    std::vector<RegistroNeutral> registros(n);
+    for (size_t i = 0; i < n; ++i) {
+        GeneradorContador aleatorio(semilla, i);
+        RegistroNeutral& r = registros[i];
+
+        bool esHombre = aleatorio.entero(2);
+        r.nombre = esHombre ? nombresMasculinos[aleatorio.entero(nombresMasculinos.size())]
+                            : nombresFemeninos[aleatorio.entero(nombresFemeninos.size())];
+        r.apellido = apellidos[aleatorio.entero(apellidos.size())] + " " + apellidos[aleatorio.entero(apellidos.size())];
+        r.id = 1000000000 + i;
+        r.ciudad = ciudadesColombia[aleatorio.entero(ciudadesColombia.size())];
+
+        int dia = 1 + aleatorio.entero(28);
+        int mes = 1 + aleatorio.entero(12);
+        int anio = 1960 + aleatorio.entero(50);
+        r.fecha = std::to_string(dia) + "/" + std::to_string(mes) + "/" + std::to_string(anio);
+
+        r.ingresos = aleatorio.real(10000000, 500000000);
+        r.patrimonio = aleatorio.real(0, 2000000000);
+        r.deudas = aleatorio.real(0, r.patrimonio * 0.7);
+        r.declarante = (r.ingresos > 50000000) && (aleatorio.entero(100) > 30);
+    }
+    return registros;
+}
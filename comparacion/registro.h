@@ -0,0 +1,38 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Datos de una persona sin el tipo de ninguna variante.
+ *
+ * POR QUÉ: medida_clases y medida_estructura definen cada una su propio Persona; para
+ *          compararlas ambas deben construirse a partir de los mismos valores.
+ * CÓMO: Un registro plano con los campos comunes; cada variante lo convierte a su Persona.
+ * PARA QUÉ: Cargas de trabajo idénticas en las dos variantes.
+ */
+struct RegistroNeutral {
+    std::string nombre;
+    std::string apellido;
+    uint64_t id;
+    std::string ciudad;
+    std::string fecha; // "D/M/AAAA"
+    double ingresos;
+    double patrimonio;
+    double deudas;
+    bool declarante;
+};
+
+/**
+ * Genera n registros reproducibles a partir de una semilla.
+ *
+ * POR QUÉ: Las dos variantes tienen generadores con rand() sin semilla fija.
+ * CÓMO: El registro i sale del GeneradorContador (semilla, i), con las mismas listas y
+ *       distribuciones que los generadores de ambas variantes; el ID es 1000000000 + i.
+ * PARA QUÉ: El mismo conjunto de datos en cada ejecución y en cada variante.
+ */
+std::vector<RegistroNeutral> generarRegistros(size_t n, uint64_t semilla);
+
+#endif // REGISTRO_H
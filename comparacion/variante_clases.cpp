@@ -0,0 +1,122 @@
+// Variante de medida_clases. Se compila con -DESPACIO_VARIANTE=clases, igual que los
+// persona.cpp, grupos.cpp y diccionario.cpp que se enlazan con ella (ver Makefile).
+#include "variantes.h"
+#include "../medida_clases/persona.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace clases {
+
+struct Conjunto {
+    ColeccionPersonas personas;
+    GruposPersonas porCiudad; // Entrada de declarantes y rankings
+};
+
+Conjunto* crearConjunto(const std::vector<RegistroNeutral>& registros) {
+    Conjunto* conjunto = new Conjunto();
+    conjunto->personas.reserve(registros.size());
+    for (const RegistroNeutral& r : registros) {
+        conjunto->personas.emplace_back(r.nombre, r.apellido, r.id, r.ciudad, r.fecha,
+                                        r.ingresos, r.patrimonio, r.deudas, r.declarante);
+    }
+    Persona::agruparCiudadRef(conjunto->personas, conjunto->porCiudad);
+    return conjunto;
+}
+
+void liberarConjunto(Conjunto* conjunto) {
+    delete conjunto;
+}
+
+// Suma de control de una agrupación: grupos y personas por grupo
+static uint64_t controlGrupos(const GruposPersonas& grupos) {
+    uint64_t control = grupos.size();
+    for (const auto& par : grupos) {
+        control = control * 31 + par.second.size();
+    }
+    return control;
+}
+
+// Suma de control de un ranking: orden de las claves y sumas truncadas a pesos
+static uint64_t controlRanking(const std::vector<std::pair<std::string, double>>& ranking) {
+    uint64_t control = ranking.size();
+    for (const auto& par : ranking) {
+        control = control * 31 + par.first.size() + static_cast<uint64_t>(par.second);
+    }
+    return control;
+}
+
+uint64_t ejecutar(Conjunto& conjunto, Operacion operacion) {
+    const ColeccionPersonas& personas = conjunto.personas;
+    switch (operacion) {
+        case EDAD_LONGEVA_PAIS_VALOR:
+            return Persona::edadMasLongevaPais(personas).getId();
+        case EDAD_LONGEVA_PAIS_REF:
+            Persona::edadMasLongevaPaisRef(personas);
+            return 0;
+        case PROMEDIO_EDAD_VALOR:
+            return static_cast<uint64_t>(Persona::promedioEdadPais(personas) * 1000);
+        case PROMEDIO_EDAD_REF:
+            Persona::promedioEdadPaisRef(personas);
+            return 0;
+        case AGRUPAR_CIUDAD_VALOR:
+            return controlGrupos(Persona::agruparCiudad(personas));
+        case AGRUPAR_CIUDAD_REF: {
+            GruposPersonas grupos;
+            Persona::agruparCiudadRef(personas, grupos);
+            return controlGrupos(grupos);
+        }
+        case AGRUPAR_CALENDARIO_VALOR:
+            return controlGrupos(Persona::agruparCalendario(personas));
+        case AGRUPAR_CALENDARIO_REF: {
+            GruposPersonas grupos;
+            Persona::agruparCalendarioRef(personas, grupos);
+            return controlGrupos(grupos);
+        }
+        case DECLARANTES_VALOR:
+            return controlGrupos(Persona::declarantesRenta(conjunto.porCiudad));
+        case DECLARANTES_REF: {
+            GruposPersonas declarantes;
+            Persona::declarantesRentaRef(conjunto.porCiudad, declarantes);
+            return controlGrupos(declarantes);
+        }
+        case RANKING_CIUDAD_VALOR:
+            return controlRanking(Persona::rankingRiquezaCiudad(conjunto.porCiudad));
+        case RANKING_CIUDAD_REF: {
+            std::vector<std::pair<std::string, double>> ranking;
+            Persona::rankingRiquezaCiudadRef(conjunto.porCiudad, ranking);
+            return controlRanking(ranking);
+        }
+        case LEER_CAMPOS: {
+            uint64_t control = 0;
+            // Los apellidos se leen por separado: getApellido() construye un string nuevo por fila.
+            // El espacio que los uniría se suma aparte para que el control coincida con estructura.
+            for (const Persona& p : personas) {
+                const std::string& nombre = p.getNombre();
+                const std::string& paterno = p.getApellidoPaterno();
+                const std::string& materno = p.getApellidoMaterno();
+                const std::string& ciudad = p.getCiudadNacimiento();
+                control += nombre.size() + paterno.size() + (materno.empty() ? 0 : materno.size() + 1) +
+                           ciudad.size() + p.getId();
+            }
+            return control;
+        }
+        case COPIAR_CAMPOS: {
+            uint64_t control = 0;
+            for (const Persona& p : personas) {
+                std::string nombre = p.getNombre();
+                std::string paterno = p.getApellidoPaterno();
+                std::string materno = p.getApellidoMaterno();
+                std::string ciudad = p.getCiudadNacimiento();
+                control += nombre.size() + paterno.size() + (materno.empty() ? 0 : materno.size() + 1) +
+                           ciudad.size() + p.getId();
+            }
+            return control;
+        }
+        default:
+            return 0;
+    }
+}
+
+} // namespace clases
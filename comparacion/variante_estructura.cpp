@@ -0,0 +1,127 @@
+// Variante de medida_estructura. Se compila con -DESPACIO_VARIANTE=estructura, que deja el
+// código de persona.h dentro de 'namespace estructura'.
+#include "variantes.h"
+#include "../medida_estructura/persona.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace estructura {
+
+struct Conjunto {
+    std::vector<Persona> personas;
+    std::map<std::string, std::vector<Persona>> porCiudad; // Entrada de declarantes y rankings
+};
+
+Conjunto* crearConjunto(const std::vector<RegistroNeutral>& registros) {
+    Conjunto* conjunto = new Conjunto();
+    conjunto->personas.reserve(registros.size());
+    for (const RegistroNeutral& r : registros) {
+        Persona p;
+        p.nombre = r.nombre;
+        p.apellido = r.apellido;
+        p.id = r.id;
+        p.ciudadNacimiento = r.ciudad;
+        p.fechaNacimiento = r.fecha;
+        p.fechaEmpaquetada = empaquetarFecha(r.fecha); // Lo que hace generarPersona
+        p.ingresosAnuales = r.ingresos;
+        p.patrimonio = r.patrimonio;
+        p.deudas = r.deudas;
+        p.declaranteRenta = r.declarante;
+        conjunto->personas.push_back(std::move(p));
+    }
+    agruparCiudadRef(conjunto->personas, conjunto->porCiudad);
+    return conjunto;
+}
+
+void liberarConjunto(Conjunto* conjunto) {
+    delete conjunto;
+}
+
+// Suma de control de una agrupación: grupos y personas por grupo
+static uint64_t controlGrupos(const std::map<std::string, std::vector<Persona>>& grupos) {
+    uint64_t control = grupos.size();
+    for (const auto& par : grupos) {
+        control = control * 31 + par.second.size();
+    }
+    return control;
+}
+
+// Suma de control de un ranking: orden de las claves y sumas truncadas a pesos
+static uint64_t controlRanking(const std::vector<std::pair<std::string, double>>& ranking) {
+    uint64_t control = ranking.size();
+    for (const auto& par : ranking) {
+        control = control * 31 + par.first.size() + static_cast<uint64_t>(par.second);
+    }
+    return control;
+}
+
+uint64_t ejecutar(Conjunto& conjunto, Operacion operacion) {
+    const std::vector<Persona>& personas = conjunto.personas;
+    switch (operacion) {
+        case EDAD_LONGEVA_PAIS_VALOR:
+            return edadMasLongevaPais(personas).id;
+        case EDAD_LONGEVA_PAIS_REF:
+            edadMasLongevaPaisRef(personas);
+            return 0;
+        case PROMEDIO_EDAD_VALOR:
+            return static_cast<uint64_t>(promedioEdadPais(personas) * 1000);
+        case PROMEDIO_EDAD_REF:
+            promedioEdadPaisRef(personas);
+            return 0;
+        case AGRUPAR_CIUDAD_VALOR:
+            return controlGrupos(agruparCiudad(personas));
+        case AGRUPAR_CIUDAD_REF: {
+            std::map<std::string, std::vector<Persona>> grupos;
+            agruparCiudadRef(personas, grupos);
+            return controlGrupos(grupos);
+        }
+        case AGRUPAR_CALENDARIO_VALOR:
+            return controlGrupos(agruparCalendario(personas));
+        case AGRUPAR_CALENDARIO_REF: {
+            std::map<std::string, std::vector<Persona>> grupos;
+            agruparCalendarioRef(personas, grupos);
+            return controlGrupos(grupos);
+        }
+        case DECLARANTES_VALOR:
+            return controlGrupos(declarantesRenta(conjunto.porCiudad));
+        case DECLARANTES_REF: {
+            std::map<std::string, std::vector<Persona>> declarantes;
+            declarantesRentaRef(conjunto.porCiudad, declarantes);
+            return controlGrupos(declarantes);
+        }
+        case RANKING_CIUDAD_VALOR:
+            return controlRanking(rankingRiquezaCiudad(conjunto.porCiudad));
+        case RANKING_CIUDAD_REF: {
+            std::vector<std::pair<std::string, double>> ranking;
+            rankingRiquezaCiudadRef(conjunto.porCiudad, ranking);
+            return controlRanking(ranking);
+        }
+        case LEER_CAMPOS: {
+            uint64_t control = 0;
+            for (const Persona& p : personas) {
+                const std::string& nombre = p.nombre;
+                const std::string& apellido = p.apellido;
+                const std::string& ciudad = p.ciudadNacimiento;
+                control += nombre.size() + apellido.size() + ciudad.size() + p.id;
+            }
+            return control;
+        }
+        case COPIAR_CAMPOS: {
+            uint64_t control = 0;
+            for (const Persona& p : personas) {
+                std::string nombre = p.nombre;
+                std::string apellido = p.apellido;
+                std::string ciudad = p.ciudadNacimiento;
+                control += nombre.size() + apellido.size() + ciudad.size() + p.id;
+            }
+            return control;
+        }
+        default:
+            return 0;
+    }
+}
+
+} // namespace estructura
@@ -0,0 +1,56 @@
+#ifndef VARIANTES_H
+#define VARIANTES_H
+
+#include "registro.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Operaciones que ambas variantes implementan
+enum Operacion {
+    EDAD_LONGEVA_PAIS_VALOR,
+    EDAD_LONGEVA_PAIS_REF,
+    PROMEDIO_EDAD_VALOR,
+    PROMEDIO_EDAD_REF,
+    AGRUPAR_CIUDAD_VALOR,
+    AGRUPAR_CIUDAD_REF,
+    AGRUPAR_CALENDARIO_VALOR,
+    AGRUPAR_CALENDARIO_REF,
+    DECLARANTES_VALOR,
+    DECLARANTES_REF,
+    RANKING_CIUDAD_VALOR,
+    RANKING_CIUDAD_REF,
+    LEER_CAMPOS,  // Nombre, apellido, ciudad e ID de cada persona sin copiarlos
+    COPIAR_CAMPOS, // Lo mismo copiando cada texto (lo que costaban los getters por valor)
+    NUM_OPERACIONES
+};
+
+// Nombre de una operación para los informes
+const char* nombreOperacion(Operacion operacion);
+
+/**
+ * Interfaz común de las variantes; cada una se compila en su propio namespace.
+ *
+ * POR QUÉ: Las dos variantes definen Persona y funciones con los mismos nombres.
+ * CÓMO: Las fuentes de cada carpeta se compilan con -DESPACIO_VARIANTE=clases o =estructura,
+ *       que las deja en ese namespace; variante_*.cpp implementan estas tres funciones.
+ * PARA QUÉ: Enlazar ambas variantes en un solo ejecutable.
+ *
+ * ejecutar() devuelve una suma de control calculada igual en ambas variantes, para comprobar
+ * que hicieron el mismo trabajo (las variantes Ref que solo imprimen devuelven 0).
+ */
+namespace clases {
+struct Conjunto;
+Conjunto* crearConjunto(const std::vector<RegistroNeutral>& registros);
+void liberarConjunto(Conjunto* conjunto);
+uint64_t ejecutar(Conjunto& conjunto, Operacion operacion);
+}
+
+namespace estructura {
+struct Conjunto;
+Conjunto* crearConjunto(const std::vector<RegistroNeutral>& registros);
+void liberarConjunto(Conjunto* conjunto);
+uint64_t ejecutar(Conjunto& conjunto, Operacion operacion);
+}
+
+#endif // VARIANTES_H
@@ -0,0 +1,286 @@
+#include "agregador.h"
+#include "monitor.h"   // TramoPerfil
+#include <algorithm> // std::sort, std::min
+#include <iostream>
+
+/**
+ * Implementación de EstadisticaGrupo::combinar.
+ *
+ * POR QUÉ: Unir el acumulado de un bloque con el de los bloques anteriores.
+ * CÓMO: Sumas y conteos se suman; máximo/mínimo con comparación estricta (gana la fila anterior).
+ * PARA QUÉ: Resultados idénticos a un recorrido fila a fila.
+ */
+void EstadisticaGrupo::combinar(const EstadisticaGrupo& otro) {
+    personas += otro.personas;
+    declarantes += otro.declarantes;
+    sumaEdades += otro.sumaEdades;
+    sumaIngresos += otro.sumaIngresos;
+    if (otro.fechaMasLongeva < fechaMasLongeva) {
+        fechaMasLongeva = otro.fechaMasLongeva;
+        filaMasLongeva = otro.filaMasLongeva;
+    }
+    if (otro.mayorPatrimonio > mayorPatrimonio) {
+        mayorPatrimonio = otro.mayorPatrimonio;
+        filaMayorPatrimonio = otro.filaMayorPatrimonio;
+    }
+}
+
+void ResultadoAgregado::reiniciar(size_t numCiudades) {
+    pais = EstadisticaGrupo();
+    ciudades.assign(numCiudades, EstadisticaGrupo());
+    for (EstadisticaGrupo& calendario : calendarios) {
+        calendario = EstadisticaGrupo();
+    }
+}
+
+void ResultadoAgregado::combinar(const ResultadoAgregado& otro) {
+    pais.combinar(otro.pais);
+    if (ciudades.size() < otro.ciudades.size()) {
+        ciudades.resize(otro.ciudades.size());
+    }
+    for (size_t c = 0; c < otro.ciudades.size(); ++c) {
+        ciudades[c].combinar(otro.ciudades[c]);
+    }
+    for (size_t g = 0; g < 3; ++g) {
+        calendarios[g].combinar(otro.calendarios[g]);
+    }
+}
+
+// Actualiza un acumulador con una fila
+static inline void acumular(EstadisticaGrupo& grupo, uint64_t fila, int32_t fecha, int edad,
+                            double ingreso, double patrimonio, bool declarante) {
+    grupo.personas++;
+    grupo.declarantes += declarante;
+    grupo.sumaEdades += edad;
+    grupo.sumaIngresos += ingreso;
+    if (fecha < grupo.fechaMasLongeva) {
+        grupo.fechaMasLongeva = fecha;
+        grupo.filaMasLongeva = fila;
+    }
+    if (patrimonio > grupo.mayorPatrimonio) {
+        grupo.mayorPatrimonio = patrimonio;
+        grupo.filaMayorPatrimonio = fila;
+    }
+}
+
+/**
+ * Implementación de agregarRango.
+ *
+ * POR QUÉ: Un único bucle que alimenta todas las estadísticas del menú.
+ * CÓMO: Lectura secuencial de seis columnas; la edad sale de la fecha empaquetada con la
+ *       misma regla que Persona::calcularEdad.
+ * PARA QUÉ: Sustituir los recorridos separados de edad, agrupación, ranking y patrimonio.
+ */
+void agregarRango(const ColumnasPersonas& columnas, size_t inicio, size_t fin, uint64_t filaBase,
+                  ResultadoAgregado& resultado) {
+    const int32_t referencia = Persona::getFechaReferencia();
+    EstadisticaGrupo* ciudades = resultado.ciudades.data();
+
+    for (size_t i = inicio; i < fin; ++i) {
+        const uint64_t fila = filaBase + i;
+        const int32_t fecha = columnas.fechaNacimiento[i];
+        const int edad = (referencia - fecha) / 10000;
+        const double ingreso = columnas.ingresos[i];
+        const double patrimonio = columnas.patrimonio[i];
+        const bool declarante = (columnas.declarante[i >> 6] >> (i & 63)) & 1u;
+
+        acumular(resultado.pais, fila, fecha, edad, ingreso, patrimonio, declarante);
+        acumular(ciudades[columnas.codigoCiudad[i]], fila, fecha, edad, ingreso, patrimonio, declarante);
+        acumular(resultado.calendarios[columnas.calendario[i]], fila, fecha, edad, ingreso, patrimonio, declarante);
+    }
+}
+
+/**
+ * Implementación de agregarEnUnaPasada.
+ *
+ * POR QUÉ: Un solo recorrido secuencial para todo el análisis.
+ * CÓMO: Bloques de TAM_BLOQUE_AGREGADO filas acumulados en un parcial que se combina en orden;
+ *       así las sumas de doubles se asocian siempre igual, sin importar cómo se reparta el trabajo.
+ * PARA QUÉ: Resultado de referencia para las opciones de análisis del menú.
+ */
+ResultadoAgregado agregarEnUnaPasada(const ColumnasPersonas& columnas, size_t numCiudades) {
+    TramoPerfil tramo("agregar una pasada");
+    ResultadoAgregado total;
+    total.reiniciar(numCiudades);
+    ResultadoAgregado parcial;
+
+    for (size_t inicio = 0; inicio < columnas.filas; inicio += TAM_BLOQUE_AGREGADO) {
+        size_t fin = std::min(columnas.filas, inicio + TAM_BLOQUE_AGREGADO);
+        parcial.reiniciar(numCiudades);
+        agregarRango(columnas, inicio, fin, 0, parcial);
+        total.combinar(parcial);
+    }
+    return total;
+}
+
+// Parcial de un hilo; alignas separa los parciales de hilos vecinos en líneas de caché distintas
+struct alignas(64) ParcialHilo {
+    ResultadoAgregado acumulado; // Bloques del hilo combinados en orden
+    ResultadoAgregado bloque;    // Bloque en curso
+};
+
+/**
+ * Implementación de agregarParalelo.
+ *
+ * POR QUÉ: La suma de doubles no es asociativa; combinar los totales de cada hilo daría
+ *          otro redondeo que el recorrido secuencial.
+ * CÓMO: 1) cada hilo agrega sus bloques y anota la suma de ingresos de cada bloque por grupo
+ *       (país, ciudades, calendarios) en 'sumasBloque'; 2) se combinan los parciales en orden
+ *       de hilo; 3) las sumas de ingresos se rehacen sumando bloque a bloque, igual que el
+ *       secuencial. Conteos y sumas enteras son exactos en cualquier orden.
+ * PARA QUÉ: Aceleración con resultados idénticos.
+ */
+ResultadoAgregado agregarParalelo(const ColumnasPersonas& columnas, size_t numCiudades, PoolHilos& pool) {
+    const size_t numBloques = (columnas.filas + TAM_BLOQUE_AGREGADO - 1) / TAM_BLOQUE_AGREGADO;
+    const size_t numHilos = pool.numHilos();
+    const size_t gruposPorBloque = 1 + numCiudades + 3;
+
+    std::vector<ParcialHilo> parciales(numHilos);
+    std::vector<double> sumasBloque(numBloques * gruposPorBloque);
+
+    pool.ejecutar([&](size_t hilo) {
+        ParcialHilo& parcial = parciales[hilo];
+        parcial.acumulado.reiniciar(numCiudades);
+        const size_t primerBloque = numBloques * hilo / numHilos;
+        const size_t ultimoBloque = numBloques * (hilo + 1) / numHilos;
+
+        for (size_t b = primerBloque; b < ultimoBloque; ++b) {
+            size_t inicio = b * TAM_BLOQUE_AGREGADO;
+            size_t fin = std::min(columnas.filas, inicio + TAM_BLOQUE_AGREGADO);
+            parcial.bloque.reiniciar(numCiudades);
+            agregarRango(columnas, inicio, fin, 0, parcial.bloque);
+
+            double* sumas = &sumasBloque[b * gruposPorBloque];
+            sumas[0] = parcial.bloque.pais.sumaIngresos;
+            for (size_t c = 0; c < numCiudades; ++c) {
+                sumas[1 + c] = parcial.bloque.ciudades[c].sumaIngresos;
+            }
+            for (size_t g = 0; g < 3; ++g) {
+                sumas[1 + numCiudades + g] = parcial.bloque.calendarios[g].sumaIngresos;
+            }
+            parcial.acumulado.combinar(parcial.bloque);
+        }
+    });
+
+    ResultadoAgregado total;
+    total.reiniciar(numCiudades);
+    for (const ParcialHilo& parcial : parciales) {
+        total.combinar(parcial.acumulado);
+    }
+
+    // Sumas de ingresos en el mismo orden que agregarEnUnaPasada
+    total.pais.sumaIngresos = 0.0;
+    for (size_t c = 0; c < numCiudades; ++c) {
+        total.ciudades[c].sumaIngresos = 0.0;
+    }
+    for (size_t g = 0; g < 3; ++g) {
+        total.calendarios[g].sumaIngresos = 0.0;
+    }
+    for (size_t b = 0; b < numBloques; ++b) {
+        const double* sumas = &sumasBloque[b * gruposPorBloque];
+        total.pais.sumaIngresos += sumas[0];
+        for (size_t c = 0; c < numCiudades; ++c) {
+            total.ciudades[c].sumaIngresos += sumas[1 + c];
+        }
+        for (size_t g = 0; g < 3; ++g) {
+            total.calendarios[g].sumaIngresos += sumas[1 + numCiudades + g];
+        }
+    }
+    return total;
+}
+
+AgregadorPorLotes::AgregadorPorLotes(size_t numCiudades) : numCiudades(numCiudades) {
+    total.reiniciar(numCiudades);
+    bloque.reiniciar(numCiudades);
+}
+
+/**
+ * Implementación de AgregadorPorLotes::agregar.
+ *
+ * POR QUÉ: Un lote puede empezar o terminar a mitad de un bloque.
+ * CÓMO: Recorre el lote en tramos que no cruzan un múltiplo global de TAM_BLOQUE_AGREGADO;
+ *       al completar un bloque lo combina con el total y empieza otro.
+ * PARA QUÉ: Mismos bloques, en el mismo orden, que agregarEnUnaPasada.
+ */
+void AgregadorPorLotes::agregar(const ColumnasPersonas& columnas, uint64_t filaBase) {
+    TramoPerfil tramo("agregar lote");
+    if (filaBase != siguienteFila) {
+        std::cerr << "Error: lote fuera de orden (fila " << filaBase << ", se esperaba " << siguienteFila << ")\n";
+        return;
+    }
+    size_t inicio = 0;
+    while (inicio < columnas.filas) {
+        const uint64_t fila = filaBase + inicio;
+        const uint64_t finBloque = (fila / TAM_BLOQUE_AGREGADO + 1) * TAM_BLOQUE_AGREGADO;
+        const size_t fin = static_cast<size_t>(std::min<uint64_t>(columnas.filas, finBloque - filaBase));
+        agregarRango(columnas, inicio, fin, filaBase, bloque);
+        if (filaBase + fin == finBloque) {
+            total.combinar(bloque);
+            bloque.reiniciar(numCiudades);
+        }
+        inicio = fin;
+    }
+    siguienteFila = filaBase + columnas.filas;
+}
+
+ResultadoAgregado AgregadorPorLotes::terminar() {
+    if (siguienteFila % TAM_BLOQUE_AGREGADO != 0) {
+        total.combinar(bloque);
+        bloque.reiniciar(numCiudades);
+    }
+    return total;
+}
+
+static bool gruposIguales(const EstadisticaGrupo& a, const EstadisticaGrupo& b) {
+    return a.personas == b.personas && a.declarantes == b.declarantes && a.sumaEdades == b.sumaEdades &&
+           a.sumaIngresos == b.sumaIngresos && a.filaMasLongeva == b.filaMasLongeva &&
+           a.filaMayorPatrimonio == b.filaMayorPatrimonio;
+}
+
+bool resultadosIguales(const ResultadoAgregado& a, const ResultadoAgregado& b) {
+    if (!gruposIguales(a.pais, b.pais) || a.ciudades.size() != b.ciudades.size()) {
+        return false;
+    }
+    for (size_t c = 0; c < a.ciudades.size(); ++c) {
+        if (!gruposIguales(a.ciudades[c], b.ciudades[c])) {
+            return false;
+        }
+    }
+    for (size_t g = 0; g < 3; ++g) {
+        if (!gruposIguales(a.calendarios[g], b.calendarios[g])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Ordena un ranking de mayor a menor suma
+static void ordenarRanking(std::vector<std::pair<std::string, double>>& ranking) {
+    std::sort(ranking.begin(), ranking.end(), [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) {
+        return a.second > b.second;
+    });
+}
+
+std::vector<std::pair<std::string, double>> rankingCiudades(const ResultadoAgregado& resultado,
+                                                            const std::vector<std::string>& nombresCiudad) {
+    std::vector<std::pair<std::string, double>> ranking;
+    for (size_t c = 0; c < resultado.ciudades.size() && c < nombresCiudad.size(); ++c) {
+        if (resultado.ciudades[c].personas > 0) {
+            ranking.emplace_back(nombresCiudad[c], resultado.ciudades[c].sumaIngresos);
+        }
+    }
+    ordenarRanking(ranking);
+    return ranking;
+}
+
+std::vector<std::pair<std::string, double>> rankingCalendarios(const ResultadoAgregado& resultado) {
+    std::vector<std::pair<std::string, double>> ranking;
+    for (size_t g = 0; g < 3; ++g) {
+        if (resultado.calendarios[g].personas > 0) {
+            ranking.emplace_back(std::string(1, TablaPersonas::letraCalendario(static_cast<uint8_t>(g))),
+                                 resultado.calendarios[g].sumaIngresos);
+        }
+    }
+    ordenarRanking(ranking);
+    return ranking;
+}
@@ -0,0 +1,142 @@
+#ifndef AGREGADOR_H
+#define AGREGADOR_H
+
+#include "tabla.h"
+#include "hilos.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Fila "ninguna" en los resultados de agregación
+const uint64_t SIN_FILA = UINT64_MAX;
+
+/**
+ * Estadísticas acumuladas de un grupo de personas (país, una ciudad o un calendario).
+ *
+ * POR QUÉ: Todas las opciones de análisis se reducen a sumas, conteos, máximos y mínimos.
+ * CÓMO: Un acumulador por grupo que se actualiza fila a fila y se puede combinar con otro.
+ * PARA QUÉ: Calcular todo en un solo recorrido y unir resultados parciales (bloques, hilos).
+ */
+struct EstadisticaGrupo {
+    uint64_t personas = 0;                 // Filas del grupo
+    uint64_t declarantes = 0;              // Declarantes de renta
+    long long sumaEdades = 0;              // Para el promedio de edad
+    double sumaIngresos = 0.0;             // Para los rankings de riqueza
+    uint64_t filaMasLongeva = SIN_FILA;    // Menor fecha de nacimiento
+    int32_t fechaMasLongeva = INT32_MAX;
+    uint64_t filaMayorPatrimonio = SIN_FILA;
+    double mayorPatrimonio = -std::numeric_limits<double>::infinity();
+
+    double promedioEdad() const { return personas ? static_cast<double>(sumaEdades) / personas : 0.0; }
+
+    /**
+     * Suma al acumulador las estadísticas de filas POSTERIORES.
+     *
+     * POR QUÉ: Unir parciales debe dar exactamente lo mismo que un recorrido secuencial.
+     * CÓMO: Sumas y conteos se suman; en máximos/mínimos solo gana 'otro' si es estrictamente
+     *       mejor, de modo que en empates conserva la primera fila, como las versiones de Persona.
+     * PARA QUÉ: Combinar bloques en orden de fila.
+     */
+    void combinar(const EstadisticaGrupo& otro);
+};
+
+/**
+ * Resultado completo del análisis de un conjunto de datos.
+ *
+ * POR QUÉ: Las opciones 6 a 15 recorrían los datos unas seis veces con copias intermedias.
+ * CÓMO: Estadísticas del país, de cada ciudad (indexadas por código) y de cada calendario.
+ * PARA QUÉ: Que el menú lea más longevos, promedios, rankings, mayores patrimonios y
+ *           conteos de declarantes de una sola pasada.
+ */
+struct ResultadoAgregado {
+    EstadisticaGrupo pais;
+    std::vector<EstadisticaGrupo> ciudades; // Índice = código de ciudad
+    EstadisticaGrupo calendarios[3];        // A, B, C
+
+    // Deja el resultado vacío con espacio para numCiudades ciudades
+    void reiniciar(size_t numCiudades);
+
+    // Combina el resultado de filas posteriores (ver EstadisticaGrupo::combinar)
+    void combinar(const ResultadoAgregado& otro);
+};
+
+// Filas por bloque: las sumas de doubles se acumulan por bloque y se combinan en orden
+const size_t TAM_BLOQUE_AGREGADO = 1 << 16;
+
+/**
+ * Acumula las filas [inicio, fin) de unas columnas en un resultado.
+ *
+ * POR QUÉ: Es el núcleo del recorrido fusionado; los demás modos (completo, por bloques)
+ *          solo deciden qué rangos se le pasan.
+ * CÓMO: Por fila lee fecha, ciudad, calendario, ingresos, patrimonio y el bit de declarante,
+ *       y actualiza los acumuladores del país, su ciudad y su calendario.
+ * PARA QUÉ: Reutilizar el mismo código para cualquier fuente columnar.
+ *
+ * @param filaBase Número de fila global de columnas[0] (para fuentes partidas en lotes).
+ */
+void agregarRango(const ColumnasPersonas& columnas, size_t inicio, size_t fin, uint64_t filaBase,
+                  ResultadoAgregado& resultado);
+
+/**
+ * Calcula todas las estadísticas en un solo recorrido de las columnas.
+ *
+ * POR QUÉ: Reemplazar varias pasadas con copias por una lectura secuencial de los datos.
+ * CÓMO: Recorre bloques de TAM_BLOQUE_AGREGADO filas con agregarRango y los combina en orden.
+ * PARA QUÉ: Alimentar el menú de análisis con un único recorrido.
+ */
+ResultadoAgregado agregarEnUnaPasada(const ColumnasPersonas& columnas, size_t numCiudades);
+
+/**
+ * Versión paralela de agregarEnUnaPasada.
+ *
+ * POR QUÉ: El recorrido es independiente por fila y los núcleos de la máquina quedan ociosos.
+ * CÓMO: Cada hilo recibe un tramo contiguo de bloques y acumula en su propio parcial
+ *       (alineado a línea de caché para evitar falso compartido). Las sumas de ingresos de
+ *       cada bloque se guardan aparte y se suman al final en orden de bloque; conteos,
+ *       máximos y mínimos se combinan en orden de hilo (= orden de filas).
+ * PARA QUÉ: Mismo resultado, bit a bit, que agregarEnUnaPasada con cualquier número de hilos.
+ */
+ResultadoAgregado agregarParalelo(const ColumnasPersonas& columnas, size_t numCiudades, PoolHilos& pool);
+
+/**
+ * Agregación incremental de una fuente que llega por lotes consecutivos de filas.
+ *
+ * POR QUÉ: Con generarPorLotes los datos nunca están completos en memoria, pero el resultado
+ *          debe ser el mismo que el de agregarEnUnaPasada sobre el conjunto entero.
+ * CÓMO: Guarda el bloque de TAM_BLOQUE_AGREGADO filas en curso entre lotes; los bloques se
+ *       cortan en múltiplos globales de TAM_BLOQUE_AGREGADO (no en los bordes de cada lote),
+ *       así que las sumas de doubles se asocian igual que en el recorrido completo.
+ * PARA QUÉ: Estadísticas bit a bit idénticas con cualquier tamaño de lote y memoria acotada.
+ */
+class AgregadorPorLotes {
+public:
+    explicit AgregadorPorLotes(size_t numCiudades);
+
+    // Acumula un lote; filaBase debe ser la fila siguiente a la última del lote anterior
+    void agregar(const ColumnasPersonas& columnas, uint64_t filaBase);
+
+    // Cierra el bloque en curso y devuelve el resultado de todas las filas agregadas
+    ResultadoAgregado terminar();
+
+    uint64_t filas() const { return siguienteFila; }
+
+private:
+    size_t numCiudades;
+    uint64_t siguienteFila = 0;
+    ResultadoAgregado total;
+    ResultadoAgregado bloque;
+};
+
+// Compara dos resultados campo a campo (sumas de doubles incluidas, sin tolerancia)
+bool resultadosIguales(const ResultadoAgregado& a, const ResultadoAgregado& b);
+
+// Ranking descendente de suma de ingresos por ciudad (nombres tomados del diccionario)
+std::vector<std::pair<std::string, double>> rankingCiudades(const ResultadoAgregado& resultado,
+                                                            const std::vector<std::string>& nombresCiudad);
+
+// Ranking descendente de suma de ingresos por calendario (A/B/C)
+std::vector<std::pair<std::string, double>> rankingCalendarios(const ResultadoAgregado& resultado);
+
+#endif // AGREGADOR_H
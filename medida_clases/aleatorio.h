@@ -0,0 +1,51 @@
+#ifndef ALEATORIO_H
+#define ALEATORIO_H
+
+#include <cstdint>
+
+/**
+ * Generador pseudoaleatorio basado en contador (SplitMix64).
+ *
+ * POR QUÉ: rand() y un std::mt19937 estático comparten estado global: no se pueden usar
+ *          desde varios hilos y el resultado depende del orden de las llamadas.
+ * CÓMO: El estado inicial se deriva solo de (semilla, flujo); cada llamada avanza un
+ *       contador y lo mezcla con el finalizador de SplitMix64. Dos flujos distintos son
+ *       independientes y no necesitan sincronización.
+ * PARA QUÉ: Que la persona i dependa solo de (semilla, i): el mismo conjunto de datos con
+ *           cualquier número de hilos y en cualquier orden de generación.
+ */
+class GeneradorContador {
+public:
+    GeneradorContador(uint64_t semilla, uint64_t flujo)
+        : estado(mezclar(semilla ^ mezclar(flujo + INCREMENTO))) {}
+
+    // Siguiente valor de 64 bits del flujo
+    uint64_t siguiente() {
+        estado += INCREMENTO;
+        return mezclar(estado);
+    }
+
+    // Entero uniforme en [0, n) (multiplicación en lugar de módulo)
+    uint32_t entero(uint32_t n) {
+        return static_cast<uint32_t>(((siguiente() >> 32) * n) >> 32);
+    }
+
+    // Real uniforme en [min, max) con 53 bits de precisión
+    double real(double min, double max) {
+        return min + (max - min) * (static_cast<double>(siguiente() >> 11) * (1.0 / 9007199254740992.0));
+    }
+
+    // Finalizador de SplitMix64 (biyectivo, buena difusión de bits)
+    static uint64_t mezclar(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    static const uint64_t INCREMENTO = 0x9e3779b97f4a7c15ULL; // Proporción áurea * 2^64
+
+    uint64_t estado;
+};
+
+#endif // ALEATORIO_H
@@ -0,0 +1,63 @@
+#include "arena.h"
+#include <algorithm> // std::max, std::max_element
+#include <cstdint>   // uintptr_t
+#include <new>       // ::operator new
+
+Arena::Arena(size_t tamBloque) : tamBloque(tamBloque) {}
+
+Arena::~Arena() {
+    for (const Bloque& bloque : bloques) {
+        ::operator delete(bloque.datos);
+    }
+}
+
+/**
+ * Implementación de do_allocate.
+ *
+ * POR QUÉ: Reservar sin cabeceras por bloque ni búsquedas de huecos.
+ * CÓMO: Alinea el desplazamiento del bloque actual; si no cabe pasa a los bloques conservados
+ *       y, al acabarse, pide uno nuevo de al menos tamBloque (o del tamaño pedido).
+ * PARA QUÉ: Reservas de coste constante para los contenedores pmr.
+ */
+void* Arena::do_allocate(size_t bytes, size_t alineacion) {
+    for (; actual < bloques.size(); ++actual, ocupado = 0) {
+        Bloque& bloque = bloques[actual];
+        uintptr_t direccion = reinterpret_cast<uintptr_t>(bloque.datos) + ocupado;
+        size_t relleno = (alineacion - direccion % alineacion) % alineacion;
+        if (ocupado + relleno + bytes <= bloque.tamano) {
+            ocupado += relleno + bytes;
+            usados += bytes;
+            return bloque.datos + ocupado - bytes;
+        }
+    }
+    size_t tamano = std::max(tamBloque, bytes + alineacion);
+    bloques.push_back(Bloque{static_cast<unsigned char*>(::operator new(tamano)), tamano});
+    actual = bloques.size() - 1;
+    ocupado = 0;
+    return do_allocate(bytes, alineacion);
+}
+
+void Arena::reiniciar() {
+    if (bloques.size() > 1) {
+        auto mayor = std::max_element(bloques.begin(), bloques.end(),
+                                      [](const Bloque& a, const Bloque& b) { return a.tamano < b.tamano; });
+        Bloque conservado = *mayor;
+        for (const Bloque& bloque : bloques) {
+            if (bloque.datos != conservado.datos) {
+                ::operator delete(bloque.datos);
+            }
+        }
+        bloques.assign(1, conservado);
+    }
+    actual = 0;
+    ocupado = 0;
+    usados = 0;
+}
+
+size_t Arena::bytesReservados() const {
+    size_t total = 0;
+    for (const Bloque& bloque : bloques) {
+        total += bloque.tamano;
+    }
+    return total;
+}
@@ -0,0 +1,52 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * Arena de memoria monótona que conserva sus bloques entre usos (recurso std::pmr).
+ *
+ * POR QUÉ: Cada opción 0 liberaba el conjunto anterior y volvía a pedir cientos de MB al
+ *          sistema (páginas nuevas que fallan al tocarlas), y cada agrupación pide sus
+ *          vectores de uno en uno.
+ * CÓMO: Reparte memoria avanzando un desplazamiento dentro de bloques grandes; liberar no
+ *       hace nada. reiniciar() vuelve al principio de una vez y conserva el bloque mayor,
+ *       de modo que el siguiente conjunto del mismo tamaño reutiliza páginas ya presentes.
+ *       No es segura entre hilos: se reserva desde el hilo de la sesión.
+ * PARA QUÉ: Colección de personas y vistas de las opciones sin reservas individuales ni
+ *           fragmentación entre regeneraciones.
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+    explicit Arena(size_t tamBloque = 1 << 20);
+    ~Arena() override;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Todo lo reservado deja de ser válido; se conserva el bloque mayor para reutilizarlo
+    void reiniciar();
+
+    size_t bytesUsados() const { return usados; }   // Desde el último reinicio
+    size_t bytesReservados() const;                 // Bloques en poder de la arena
+
+private:
+    struct Bloque {
+        unsigned char* datos;
+        size_t tamano;
+    };
+
+    std::vector<Bloque> bloques;
+    size_t actual = 0;  // Bloque en uso
+    size_t ocupado = 0; // Bytes usados del bloque actual
+    size_t usados = 0;
+    size_t tamBloque;
+
+    void* do_allocate(size_t bytes, size_t alineacion) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& otro) const noexcept override { return this == &otro; }
+};
+
+#endif // ARENA_H
@@ -0,0 +1,122 @@
+#include "asignaciones.h"
+#include <atomic>
+#include <cstdlib>   // std::malloc, std::free, std::aligned_alloc
+#include <new>       // std::bad_alloc, std::align_val_t
+#include <malloc.h>  // malloc_usable_size
+
+static std::atomic<bool> activo(false);
+static std::atomic<uint64_t> asignaciones(0);
+static std::atomic<uint64_t> liberaciones(0);
+static std::atomic<uint64_t> bytesPedidos(0);
+static std::atomic<int64_t> bytesVivos(0);
+static std::atomic<int64_t> picoVivos(0);
+
+// Anota una reserva; el pico se actualiza con compare-exchange (varios hilos pueden reservar)
+static void anotarReserva(void* bloque, size_t pedidos) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    bytesPedidos.fetch_add(pedidos, std::memory_order_relaxed);
+    int64_t vivos = bytesVivos.fetch_add(malloc_usable_size(bloque), std::memory_order_relaxed) +
+                    static_cast<int64_t>(malloc_usable_size(bloque));
+    int64_t pico = picoVivos.load(std::memory_order_relaxed);
+    while (vivos > pico && !picoVivos.compare_exchange_weak(pico, vivos, std::memory_order_relaxed)) {
+    }
+}
+
+static void anotarLiberacion(void* bloque) {
+    liberaciones.fetch_add(1, std::memory_order_relaxed);
+    bytesVivos.fetch_sub(malloc_usable_size(bloque), std::memory_order_relaxed);
+}
+
+static void* reservar(size_t bytes) {
+    void* bloque = std::malloc(bytes ? bytes : 1);
+    if (bloque && activo.load(std::memory_order_relaxed)) {
+        anotarReserva(bloque, bytes);
+    }
+    return bloque;
+}
+
+static void* reservarAlineado(size_t bytes, std::align_val_t alineacion) {
+    size_t alinear = static_cast<size_t>(alineacion);
+    // aligned_alloc exige un tamaño múltiplo de la alineación
+    void* bloque = std::aligned_alloc(alinear, (bytes + alinear - 1) / alinear * alinear);
+    if (bloque && activo.load(std::memory_order_relaxed)) {
+        anotarReserva(bloque, bytes);
+    }
+    return bloque;
+}
+
+static void liberar(void* bloque) noexcept {
+    if (bloque) {
+        if (activo.load(std::memory_order_relaxed)) {
+            anotarLiberacion(bloque);
+        }
+        std::free(bloque);
+    }
+}
+
+void activarSeguimientoAsignaciones() {
+    activo.store(true);
+}
+
+bool seguimientoAsignacionesActivo() {
+    return activo.load();
+}
+
+EstadoAsignaciones leerAsignaciones() {
+    return EstadoAsignaciones{asignaciones.load(), liberaciones.load(), bytesPedidos.load(),
+                              bytesVivos.load(), picoVivos.load()};
+}
+
+void reiniciarPicoAsignaciones() {
+    picoVivos.store(bytesVivos.load());
+}
+
+// --- Reemplazo de los operadores globales ---
+
+void* operator new(size_t bytes) {
+    void* bloque = reservar(bytes);
+    if (!bloque) throw std::bad_alloc();
+    return bloque;
+}
+
+void* operator new[](size_t bytes) {
+    void* bloque = reservar(bytes);
+    if (!bloque) throw std::bad_alloc();
+    return bloque;
+}
+
+void* operator new(size_t bytes, const std::nothrow_t&) noexcept { return reservar(bytes); }
+void* operator new[](size_t bytes, const std::nothrow_t&) noexcept { return reservar(bytes); }
+
+void* operator new(size_t bytes, std::align_val_t alineacion) {
+    void* bloque = reservarAlineado(bytes, alineacion);
+    if (!bloque) throw std::bad_alloc();
+    return bloque;
+}
+
+void* operator new[](size_t bytes, std::align_val_t alineacion) {
+    void* bloque = reservarAlineado(bytes, alineacion);
+    if (!bloque) throw std::bad_alloc();
+    return bloque;
+}
+
+void* operator new(size_t bytes, std::align_val_t alineacion, const std::nothrow_t&) noexcept {
+    return reservarAlineado(bytes, alineacion);
+}
+
+void* operator new[](size_t bytes, std::align_val_t alineacion, const std::nothrow_t&) noexcept {
+    return reservarAlineado(bytes, alineacion);
+}
+
+void operator delete(void* bloque) noexcept { liberar(bloque); }
+void operator delete[](void* bloque) noexcept { liberar(bloque); }
+void operator delete(void* bloque, size_t) noexcept { liberar(bloque); }
+void operator delete[](void* bloque, size_t) noexcept { liberar(bloque); }
+void operator delete(void* bloque, const std::nothrow_t&) noexcept { liberar(bloque); }
+void operator delete[](void* bloque, const std::nothrow_t&) noexcept { liberar(bloque); }
+void operator delete(void* bloque, std::align_val_t) noexcept { liberar(bloque); }
+void operator delete[](void* bloque, std::align_val_t) noexcept { liberar(bloque); }
+void operator delete(void* bloque, size_t, std::align_val_t) noexcept { liberar(bloque); }
+void operator delete[](void* bloque, size_t, std::align_val_t) noexcept { liberar(bloque); }
+void operator delete(void* bloque, std::align_val_t, const std::nothrow_t&) noexcept { liberar(bloque); }
+void operator delete[](void* bloque, std::align_val_t, const std::nothrow_t&) noexcept { liberar(bloque); }
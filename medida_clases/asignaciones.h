@@ -0,0 +1,37 @@
+#ifndef ASIGNACIONES_H
+#define ASIGNACIONES_H
+
+#include <cstdint>
+
+/**
+ * Contadores de memoria dinámica del proceso.
+ *
+ * POR QUÉ: El tiempo no muestra cuánta memoria copia una variante por valor frente a una
+ *          por referencia; el número de reservas y sus bytes sí.
+ * CÓMO: asignaciones.cpp reemplaza los operadores globales new/delete (todas sus formas) y,
+ *       una vez activado el seguimiento, suma con atómicos cada reserva y liberación. Sin
+ *       activarlo los operadores solo comprueban una bandera y llaman a malloc/free.
+ * PARA QUÉ: Medir bytes reservados y pico de memoria viva por operación (Monitor, benchmark).
+ */
+struct EstadoAsignaciones {
+    uint64_t asignaciones; // Llamadas a new
+    uint64_t liberaciones; // Llamadas a delete (con puntero no nulo)
+    uint64_t bytes;        // Bytes pedidos en total
+    int64_t vivos;         // Bytes vivos ahora (tamaño real de cada bloque)
+    int64_t picoVivos;     // Máximo de 'vivos' desde el último reinicio del pico
+};
+
+// Empieza a contar reservas y liberaciones (no se puede desactivar: los bloques vivos se
+// descuentan al liberarse). Conviene llamarla al inicio del programa.
+void activarSeguimientoAsignaciones();
+
+// true si activarSeguimientoAsignaciones() ya se llamó
+bool seguimientoAsignacionesActivo();
+
+// Foto de los contadores actuales
+EstadoAsignaciones leerAsignaciones();
+
+// Lleva el pico de memoria viva al valor actual (para medir el pico de una operación)
+void reiniciarPicoAsignaciones();
+
+#endif // ASIGNACIONES_H
@@ -0,0 +1,370 @@
+/**
+ * Benchmark de las variantes por valor y por referencia de las funciones de Persona.
+ *
+ * POR QUÉ: Las parejas Valor/Referencia existen para comparar ambos pasos de parámetros,
+ *          pero el menú solo da una medición ruidosa por acción.
+ * CÓMO: Para cada tamaño del barrido (1e3 a 1e7 por defecto) genera un conjunto con semilla
+ *       fija y mide cada variante con calentamiento y repeticiones: mediana, p95, p99, desviación,
+ *       bytes y reservas de memoria dinámica por ejecución y pico de RSS (VmHWM). La salida
+ *       estándar de las funciones se descarta durante las mediciones.
+ * PARA QUÉ: Números repetibles en CSV y JSON (make bench).
+ */
+#include "persona.h"
+#include "generador.h"
+#include "tabla.h"
+#include "hilos.h"
+#include "grupos.h"
+#include "asignaciones.h"
+#include "monitor.h"     // calcularEstadisticas
+#include <algorithm> // std::max
+#include <chrono>
+#include <cstdio>    // FILE, fopen
+#include <cstring>   // std::strcmp, std::strncmp
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Parámetros del barrido (modificables por línea de comandos)
+struct ConfiguracionBench {
+    size_t minimo = 1000;
+    size_t maximo = 10000000;
+    int calentamiento = 1;
+    int repeticiones = 5;
+    uint64_t semilla = 1;
+    std::string csv = "bench.csv";
+    std::string json = "bench.json";
+};
+
+// Resultado de una variante sobre un tamaño
+struct ResultadoBench {
+    std::string funcion;
+    std::string variante;
+    size_t n;
+    int repeticiones;
+    double mediana, p95, p99, desviacion, media, minimo, intervalo95; // ms
+    double bytesPorEjecucion;
+    double reservasPorEjecucion;
+    int64_t picoHeap; // Bytes vivos por encima del inicio (máximo de las repeticiones)
+    long picoRSS;     // KB (máximo de las repeticiones)
+};
+
+// Variante a medir: 'ejecutar' llama a la función una vez
+struct CasoBench {
+    std::string funcion;
+    std::string variante;
+    std::function<void()> ejecutar;
+};
+
+// Descarta todo lo que se escribe (sustituye a std::cout durante las mediciones)
+class SalidaNula : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Evita que el compilador descarte resultados no usados
+static volatile size_t sumidero = 0;
+
+// Reinicia el pico de RSS del proceso (escribiendo 5 en /proc/self/clear_refs)
+static bool reiniciarPicoRSS() {
+    FILE* archivo = fopen("/proc/self/clear_refs", "w");
+    if (!archivo) {
+        return false;
+    }
+    bool correcto = fputs("5", archivo) >= 0;
+    return fclose(archivo) == 0 && correcto;
+}
+
+// Pico de RSS (VmHWM) en KB, o 0 si no se puede leer
+static long leerPicoRSS() {
+    FILE* archivo = fopen("/proc/self/status", "r");
+    if (!archivo) {
+        return 0;
+    }
+    char linea[256];
+    long pico = 0;
+    while (fgets(linea, sizeof(linea), archivo)) {
+        if (std::strncmp(linea, "VmHWM:", 6) == 0) {
+            pico = std::atol(linea + 6);
+            break;
+        }
+    }
+    fclose(archivo);
+    return pico;
+}
+
+/**
+ * Mide una variante: calentamiento, repeticiones y estadísticas.
+ *
+ * POR QUÉ: Una sola muestra mezcla efectos de caché fría, páginas nuevas y ruido.
+ * CÓMO: Las ejecuciones de calentamiento no se miden; en cada repetición se reinician los
+ *       picos (RSS y heap) y se toman tiempo, reservas y bytes.
+ * PARA QUÉ: Resultados comparables entre variantes y tamaños.
+ */
+static ResultadoBench medir(const CasoBench& caso, size_t n, const ConfiguracionBench& config, bool& rssReiniciable) {
+    for (int i = 0; i < config.calentamiento; ++i) {
+        caso.ejecutar();
+    }
+
+    std::vector<double> tiempos;
+    double bytes = 0, reservas = 0;
+    int64_t picoHeap = 0;
+    long picoRSS = 0;
+    for (int i = 0; i < config.repeticiones; ++i) {
+        rssReiniciable = reiniciarPicoRSS() && rssReiniciable;
+        reiniciarPicoAsignaciones();
+        EstadoAsignaciones antes = leerAsignaciones();
+
+        auto inicio = std::chrono::steady_clock::now();
+        caso.ejecutar();
+        auto fin = std::chrono::steady_clock::now();
+
+        EstadoAsignaciones despues = leerAsignaciones();
+        tiempos.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(fin - inicio).count() / 1e6);
+        bytes += static_cast<double>(despues.bytes - antes.bytes);
+        reservas += static_cast<double>(despues.asignaciones - antes.asignaciones);
+        picoHeap = std::max(picoHeap, despues.picoVivos - antes.vivos);
+        picoRSS = std::max(picoRSS, leerPicoRSS());
+    }
+
+    ResultadoBench resultado;
+    resultado.funcion = caso.funcion;
+    resultado.variante = caso.variante;
+    resultado.n = n;
+    resultado.repeticiones = config.repeticiones;
+
+    EstadisticasTiempo estadisticas = calcularEstadisticas(tiempos);
+    resultado.media = estadisticas.media;
+    resultado.desviacion = estadisticas.desviacion;
+    resultado.minimo = estadisticas.minimo;
+    resultado.mediana = estadisticas.mediana;
+    resultado.p95 = estadisticas.p95;
+    resultado.p99 = estadisticas.p99;
+    resultado.intervalo95 = estadisticas.intervalo95;
+    resultado.bytesPorEjecucion = bytes / config.repeticiones;
+    resultado.reservasPorEjecucion = reservas / config.repeticiones;
+    resultado.picoHeap = picoHeap;
+    resultado.picoRSS = picoRSS;
+    return resultado;
+}
+
+/**
+ * Parejas Valor/Referencia sobre un conjunto de datos.
+ *
+ * POR QUÉ: Cada pareja debe recibir exactamente las mismas entradas.
+ * CÓMO: Las entradas agrupadas (mapas por calendario y ciudad, vistas) se calculan una vez
+ *       por tamaño, fuera de la medición; las variantes se capturan como lambdas.
+ * PARA QUÉ: Lista de casos que el barrido mide en orden.
+ */
+struct EntradasBench {
+    std::unique_ptr<ColeccionPersonas> personas;
+    GruposPersonas porCalendario;
+    GruposPersonas porCiudad;
+    VistaGrupos vistaCalendario;
+    VistaGrupos vistaCiudad;
+};
+
+static std::vector<CasoBench> construirCasos(EntradasBench& e) {
+    const ColeccionPersonas& p = *e.personas;
+    std::vector<CasoBench> casos;
+
+    casos.push_back({"edadMasLongevaPais", "Valor", [&] { sumidero = Persona::edadMasLongevaPais(p).getId(); }});
+    casos.push_back({"edadMasLongevaPais", "Referencia", [&] { Persona::edadMasLongevaPaisRef(p); }});
+    casos.push_back({"promedioEdadPais", "Valor", [&] { sumidero = static_cast<size_t>(Persona::promedioEdadPais(p)); }});
+    casos.push_back({"promedioEdadPais", "Referencia", [&] { Persona::promedioEdadPaisRef(p); }});
+    casos.push_back({"edadMasLongevaCiudad", "Valor", [&] { sumidero = Persona::edadMasLongevaCiudad(p).size(); }});
+    casos.push_back({"edadMasLongevaCiudad", "Referencia", [&] { Persona::edadMasLongevaCiudadRef(p); }});
+
+    casos.push_back({"agruparCalendario", "Valor", [&] { sumidero = Persona::agruparCalendario(p).size(); }});
+    casos.push_back({"agruparCalendario", "Referencia", [&] {
+        GruposPersonas grupos;
+        Persona::agruparCalendarioRef(p, grupos);
+        sumidero = grupos.size();
+    }});
+    casos.push_back({"agruparCiudad", "Valor", [&] { sumidero = Persona::agruparCiudad(p).size(); }});
+    casos.push_back({"agruparCiudad", "Referencia", [&] {
+        GruposPersonas grupos;
+        Persona::agruparCiudadRef(p, grupos);
+        sumidero = grupos.size();
+    }});
+
+    casos.push_back({"declarantesRenta", "Valor", [&] { sumidero = Persona::declarantesRenta(e.porCalendario).size(); }});
+    casos.push_back({"declarantesRenta", "Referencia", [&] {
+        GruposPersonas declarantes;
+        Persona::declarantesRentaRef(e.porCalendario, declarantes);
+        sumidero = declarantes.size();
+    }});
+    casos.push_back({"rankingRiqueza", "Valor", [&] { sumidero = Persona::rankingRiqueza(e.porCalendario).size(); }});
+    casos.push_back({"rankingRiqueza", "Referencia", [&] {
+        std::vector<std::pair<std::string, double>> ranking;
+        Persona::rankingRiquezaRef(e.porCalendario, ranking);
+        sumidero = ranking.size();
+    }});
+    casos.push_back({"rankingRiquezaCiudad", "Valor", [&] { sumidero = Persona::rankingRiquezaCiudad(e.porCiudad).size(); }});
+    casos.push_back({"rankingRiquezaCiudad", "Referencia", [&] {
+        std::vector<std::pair<std::string, double>> ranking;
+        Persona::rankingRiquezaCiudadRef(e.porCiudad, ranking);
+        sumidero = ranking.size();
+    }});
+
+    // El submenú de patrimonio lee la opción de std::cin: se responde "1" (país) en cada llamada
+    casos.push_back({"mayorPatrimonioPais", "Valor", [&] {
+        std::istringstream respuesta("1\n");
+        std::streambuf* teclado = std::cin.rdbuf(respuesta.rdbuf());
+        Persona::mostrarMayorPatrimonioPorValor(p);
+        std::cin.rdbuf(teclado);
+    }});
+    casos.push_back({"mayorPatrimonioPais", "Referencia", [&] {
+        std::istringstream respuesta("1\n");
+        std::streambuf* teclado = std::cin.rdbuf(respuesta.rdbuf());
+        Persona::mostrarMayorPatrimonioPorReferencia(e.personas);
+        std::cin.rdbuf(teclado);
+    }});
+
+    // Vistas de agrupación (devuelta / llenada por referencia)
+    casos.push_back({"agruparCiudadVista", "Valor", [&] { sumidero = Persona::agruparCiudadVista(p).filas.size(); }});
+    casos.push_back({"agruparCiudadVista", "Referencia", [&] {
+        VistaGrupos vista;
+        Persona::agruparCiudadVistaRef(p, vista);
+        sumidero = vista.filas.size();
+    }});
+    casos.push_back({"declarantesRentaVista", "Valor", [&] {
+        sumidero = Persona::declarantesRentaVista(e.vistaCalendario, p).filas.size();
+    }});
+    casos.push_back({"declarantesRentaVista", "Referencia", [&] {
+        VistaGrupos declarantes;
+        Persona::declarantesRentaVistaRef(e.vistaCalendario, p, declarantes);
+        sumidero = declarantes.filas.size();
+    }});
+    casos.push_back({"rankingRiquezaVista", "Valor", [&] { sumidero = Persona::rankingRiquezaVista(e.vistaCiudad, p).size(); }});
+    casos.push_back({"rankingRiquezaVista", "Referencia", [&] {
+        std::vector<std::pair<std::string, double>> ranking;
+        Persona::rankingRiquezaVistaRef(e.vistaCiudad, p, ranking);
+        sumidero = ranking.size();
+    }});
+    return casos;
+}
+
+static void escribirCSV(const std::string& ruta, const std::vector<ResultadoBench>& resultados) {
+    std::ofstream archivo(ruta);
+    if (!archivo) {
+        std::cerr << "Error al abrir archivo: " << ruta << std::endl;
+        return;
+    }
+    archivo << "funcion,variante,n,repeticiones,mediana_ms,p95_ms,p99_ms,desviacion_ms,media_ms,ic95_ms,min_ms,"
+               "bytes_por_ejecucion,reservas_por_ejecucion,pico_heap_bytes,pico_rss_kb\n";
+    for (const ResultadoBench& r : resultados) {
+        archivo << r.funcion << "," << r.variante << "," << r.n << "," << r.repeticiones << ","
+                << r.mediana << "," << r.p95 << "," << r.p99 << "," << r.desviacion << "," << r.media << ","
+                << r.intervalo95 << "," << r.minimo << ","
+                << r.bytesPorEjecucion << "," << r.reservasPorEjecucion << "," << r.picoHeap << "," << r.picoRSS << "\n";
+    }
+}
+
+static void escribirJSON(const std::string& ruta, const std::vector<ResultadoBench>& resultados) {
+    std::ofstream archivo(ruta);
+    if (!archivo) {
+        std::cerr << "Error al abrir archivo: " << ruta << std::endl;
+        return;
+    }
+    archivo << "[\n";
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        const ResultadoBench& r = resultados[i];
+        archivo << "  {\"funcion\": \"" << r.funcion << "\", \"variante\": \"" << r.variante << "\", \"n\": " << r.n
+                << ", \"repeticiones\": " << r.repeticiones << ", \"mediana_ms\": " << r.mediana
+                << ", \"p95_ms\": " << r.p95 << ", \"p99_ms\": " << r.p99 << ", \"desviacion_ms\": " << r.desviacion
+                << ", \"media_ms\": " << r.media << ", \"ic95_ms\": " << r.intervalo95 << ", \"min_ms\": " << r.minimo
+                << ", \"bytes_por_ejecucion\": " << r.bytesPorEjecucion
+                << ", \"reservas_por_ejecucion\": " << r.reservasPorEjecucion
+                << ", \"pico_heap_bytes\": " << r.picoHeap << ", \"pico_rss_kb\": " << r.picoRSS << "}"
+                << (i + 1 < resultados.size() ? ",\n" : "\n");
+    }
+    archivo << "]\n";
+}
+
+static void mostrarUso(const char* programa) {
+    std::cerr << "Uso: " << programa << " [--min N] [--max N] [--calentamiento W] [--repeticiones R]"
+              << " [--semilla S] [--csv archivo] [--json archivo]\n"
+              << "Mide con n = min, min*10, min*100... mientras n <= max (por omisión 1000 a 10000000)\n";
+}
+
+// Interpreta los argumentos; false (tras mostrar el uso) si alguno no es válido
+static bool leerArgumentos(int argc, char* argv[], ConfiguracionBench& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string nombre = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Falta el valor de " << nombre << "\n";
+            return false;
+        }
+        std::string valor = argv[++i];
+        if (nombre == "--min") config.minimo = std::stoull(valor);
+        else if (nombre == "--max") config.maximo = std::stoull(valor);
+        else if (nombre == "--calentamiento") config.calentamiento = std::stoi(valor);
+        else if (nombre == "--repeticiones") config.repeticiones = std::stoi(valor);
+        else if (nombre == "--semilla") config.semilla = std::stoull(valor);
+        else if (nombre == "--csv") config.csv = valor;
+        else if (nombre == "--json") config.json = valor;
+        else {
+            mostrarUso(argv[0]);
+            return false;
+        }
+    }
+    if (config.minimo == 0 || config.minimo > config.maximo) {
+        std::cerr << "Se necesita 0 < --min <= --max\n";
+        mostrarUso(argv[0]);
+        return false;
+    }
+    return config.repeticiones > 0 && config.calentamiento >= 0;
+}
+
+int main(int argc, char* argv[]) {
+    activarSeguimientoAsignaciones();
+    ConfiguracionBench config;
+    try {
+        if (!leerArgumentos(argc, argv, config)) {
+            return 2;
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Argumento numérico inválido\n";
+        return 2;
+    }
+
+    PoolHilos pool;
+    SalidaNula nula;
+    std::vector<ResultadoBench> resultados;
+    bool rssReiniciable = true;
+
+    for (size_t n = config.minimo; n <= config.maximo; n *= 10) {
+        std::cerr << "n = " << n << ": generando datos...\n";
+        EntradasBench entradas;
+        TablaPersonas tabla;
+        entradas.personas = std::make_unique<ColeccionPersonas>(generarColeccion(n, config.semilla, tabla, pool));
+        entradas.porCalendario = Persona::agruparCalendario(*entradas.personas);
+        entradas.porCiudad = Persona::agruparCiudad(*entradas.personas);
+        entradas.vistaCalendario = Persona::agruparCalendarioVista(*entradas.personas);
+        entradas.vistaCiudad = Persona::agruparCiudadVista(*entradas.personas);
+
+        for (const CasoBench& caso : construirCasos(entradas)) {
+            std::streambuf* consola = std::cout.rdbuf(&nula);
+            ResultadoBench resultado = medir(caso, n, config, rssReiniciable);
+            std::cout.rdbuf(consola);
+
+            std::cerr << "  " << caso.funcion << " [" << caso.variante << "]: mediana " << resultado.mediana
+                      << " ms, p95 " << resultado.p95 << " ms, " << resultado.bytesPorEjecucion << " bytes\n";
+            resultados.push_back(resultado);
+        }
+    }
+
+    if (!rssReiniciable) {
+        std::cerr << "Aviso: no se pudo reiniciar VmHWM (/proc/self/clear_refs); "
+                     "pico_rss_kb es el pico acumulado del proceso\n";
+    }
+    escribirCSV(config.csv, resultados);
+    escribirJSON(config.json, resultados);
+    std::cerr << "Resultados en " << config.csv << " y " << config.json << "\n";
+    return 0;
+}
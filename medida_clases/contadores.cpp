@@ -0,0 +1,126 @@
+#include "contadores.h"
+#include <cstring>             // std::memset
+#include <linux/perf_event.h>  // perf_event_attr
+#include <sys/ioctl.h>         // ioctl
+#include <sys/resource.h>      // getrusage
+#include <sys/syscall.h>       // SYS_perf_event_open
+#include <unistd.h>            // syscall, read, close
+
+// Abre un contador del hilo actual (y de los hilos que cree después); -1 si no está disponible
+static int abrirContador(uint32_t tipo, uint64_t configuracion) {
+    perf_event_attr atributos;
+    std::memset(&atributos, 0, sizeof(atributos));
+    atributos.size = sizeof(atributos);
+    atributos.type = tipo;
+    atributos.config = configuracion;
+    atributos.disabled = 1;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    atributos.inherit = 1;
+    atributos.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0));
+}
+
+static long fallosPaginaRusage() {
+    rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return uso.ru_minflt + uso.ru_majflt;
+}
+
+// Tiempo de CPU (usuario + sistema) del proceso en nanosegundos
+static uint64_t tiempoCpuRusage() {
+    rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    return (static_cast<uint64_t>(uso.ru_utime.tv_sec + uso.ru_stime.tv_sec) * 1000000 +
+            uso.ru_utime.tv_usec + uso.ru_stime.tv_usec) * 1000;
+}
+
+ContadoresRendimiento::ContadoresRendimiento() {
+    const uint64_t fallosL1d = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                               (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    descriptores[CICLOS] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    descriptores[INSTRUCCIONES] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    descriptores[REFERENCIAS_CACHE] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES);
+    descriptores[FALLOS_CACHE] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    descriptores[FALLOS_L1D] = abrirContador(PERF_TYPE_HW_CACHE, fallosL1d);
+    descriptores[FALLOS_SALTO] = abrirContador(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    descriptores[TIEMPO_CPU] = abrirContador(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK);
+    descriptores[FALLOS_PAGINA] = abrirContador(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+}
+
+ContadoresRendimiento::~ContadoresRendimiento() {
+    for (int fd : descriptores) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+bool ContadoresRendimiento::hardwareDisponible() const {
+    for (int evento = CICLOS; evento <= FALLOS_SALTO; ++evento) {
+        if (descriptores[evento] >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ContadoresRendimiento::iniciar() {
+    for (int fd : descriptores) {
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    fallosPaginaInicio = fallosPaginaRusage();
+    tiempoCpuInicio = tiempoCpuRusage();
+}
+
+/**
+ * Implementación de detener.
+ *
+ * POR QUÉ: Con más eventos que contadores físicos, el núcleo los reparte en el tiempo.
+ * CÓMO: Se escala cada valor por tiempo_habilitado / tiempo_en_ejecución.
+ * PARA QUÉ: Estimaciones comparables aunque haya multiplexación.
+ */
+LecturaContadores ContadoresRendimiento::detener() {
+    LecturaContadores lectura;
+    for (int evento = 0; evento < NUM_EVENTOS; ++evento) {
+        int fd = descriptores[evento];
+        lectura.valores[evento] = 0;
+        lectura.disponible[evento] = false;
+        if (fd < 0) {
+            continue;
+        }
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t datos[3]; // valor, tiempo habilitado, tiempo en ejecución
+        if (read(fd, datos, sizeof(datos)) == static_cast<ssize_t>(sizeof(datos)) && datos[2] > 0) {
+            lectura.valores[evento] = datos[2] < datos[1]
+                ? static_cast<uint64_t>(static_cast<double>(datos[0]) * datos[1] / datos[2]) : datos[0];
+            lectura.disponible[evento] = true;
+        }
+    }
+    if (!lectura.disponible[FALLOS_PAGINA]) {
+        lectura.valores[FALLOS_PAGINA] = static_cast<uint64_t>(fallosPaginaRusage() - fallosPaginaInicio);
+        lectura.disponible[FALLOS_PAGINA] = true;
+    }
+    if (!lectura.disponible[TIEMPO_CPU]) {
+        lectura.valores[TIEMPO_CPU] = tiempoCpuRusage() - tiempoCpuInicio;
+        lectura.disponible[TIEMPO_CPU] = true;
+    }
+    return lectura;
+}
+
+const char* ContadoresRendimiento::nombreEvento(EventoContador evento) {
+    switch (evento) {
+        case CICLOS: return "ciclos";
+        case INSTRUCCIONES: return "instrucciones";
+        case REFERENCIAS_CACHE: return "referencias_cache";
+        case FALLOS_CACHE: return "fallos_cache";
+        case FALLOS_L1D: return "fallos_l1d";
+        case FALLOS_SALTO: return "fallos_salto";
+        case TIEMPO_CPU: return "tiempo_cpu_ns";
+        case FALLOS_PAGINA: return "fallos_pagina";
+        default: return "?";
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include <cstdint>
+
+// Eventos que se intentan medir con perf_event_open
+enum EventoContador {
+    CICLOS,
+    INSTRUCCIONES,
+    REFERENCIAS_CACHE, // Accesos al último nivel de caché
+    FALLOS_CACHE,      // Fallos del último nivel de caché
+    FALLOS_L1D,        // Fallos de lectura de la caché L1 de datos
+    FALLOS_SALTO,      // Saltos mal predichos
+    // Software: disponibles aunque no haya contadores de hardware (respaldo con getrusage)
+    TIEMPO_CPU,        // Nanosegundos de CPU de los hilos medidos
+    FALLOS_PAGINA,
+    NUM_EVENTOS
+};
+
+// Valores de un intervalo; 'disponible' indica qué eventos se pudieron medir
+struct LecturaContadores {
+    uint64_t valores[NUM_EVENTOS];
+    bool disponible[NUM_EVENTOS];
+};
+
+/**
+ * Contadores de rendimiento del proceso (perf_event_open).
+ *
+ * POR QUÉ: El tiempo no explica por qué una variante es más lenta; los fallos de caché y las
+ *          instrucciones por ciclo sí.
+ * CÓMO: Un descriptor perf por evento, solo espacio de usuario y heredado por los hilos que se
+ *       creen después. Los eventos que el sistema no ofrece (máquinas virtuales sin PMU,
+ *       perf_event_paranoid alto) quedan como no disponibles; tiempo de CPU y fallos de
+ *       página recurren a getrusage si tampoco hay contadores de software.
+ * PARA QUÉ: Medir el comportamiento de caché por operación sin herramientas externas.
+ */
+class ContadoresRendimiento {
+public:
+    ContadoresRendimiento();
+    ~ContadoresRendimiento();
+
+    ContadoresRendimiento(const ContadoresRendimiento&) = delete;
+    ContadoresRendimiento& operator=(const ContadoresRendimiento&) = delete;
+
+    // true si al menos un contador de hardware está disponible
+    bool hardwareDisponible() const;
+
+    // Pone los contadores a cero y los activa
+    void iniciar();
+
+    // Detiene los contadores y devuelve lo contado desde iniciar()
+    LecturaContadores detener();
+
+    static const char* nombreEvento(EventoContador evento);
+
+private:
+    int descriptores[NUM_EVENTOS];
+    // Respaldo con getrusage
+    long fallosPaginaInicio = 0;
+    uint64_t tiempoCpuInicio = 0; // ns
+};
+
+#endif // CONTADORES_H
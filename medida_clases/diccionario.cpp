@@ -0,0 +1,66 @@
+#include "diccionario.h"
+#include <stdexcept>
+
+INICIO_VARIANTE
+
+DiccionarioTextos::DiccionarioTextos(size_t limite)
+    : limite(limite < LIMITE_CODIGOS ? limite : LIMITE_CODIGOS), cantidad(0) {
+    for (auto& pagina : paginas) {
+        pagina.store(nullptr, std::memory_order_relaxed);
+    }
+    codificar(""); // Código 0
+}
+
+DiccionarioTextos::~DiccionarioTextos() {
+    for (auto& pagina : paginas) {
+        delete[] pagina.load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Implementación de codificar.
+ *
+ * POR QUÉ: Varios hilos pueden crear personas desde texto a la vez.
+ * CÓMO: Con el mutex tomado busca el texto; si es nuevo lo copia en la siguiente posición de
+ *       su página (creándola si hace falta) y publica la nueva cantidad. Con el diccionario
+ *       lleno lanza std::length_error, como TablaPersonas con las ciudades.
+ * PARA QUÉ: Códigos únicos por texto sin bloquear a quien solo lee textos.
+ */
+uint16_t DiccionarioTextos::codificar(const std::string& texto) {
+    std::lock_guard<std::mutex> bloqueo(mutex);
+    auto it = codigos.find(texto);
+    if (it != codigos.end()) {
+        return it->second;
+    }
+    size_t codigo = cantidad.load(std::memory_order_relaxed);
+    if (codigo >= limite) {
+        // Devolver un código cualquiera mezclaría textos distintos sin que nadie lo note
+        throw std::length_error("DiccionarioTextos: más de " + std::to_string(limite) + " textos distintos");
+    }
+    std::string* pagina = paginas[codigo / TAM_PAGINA].load(std::memory_order_relaxed);
+    if (!pagina) {
+        pagina = new std::string[TAM_PAGINA];
+        paginas[codigo / TAM_PAGINA].store(pagina, std::memory_order_release);
+    }
+    pagina[codigo % TAM_PAGINA] = texto;
+    codigos.emplace(texto, static_cast<uint16_t>(codigo));
+    cantidad.store(codigo + 1, std::memory_order_release);
+    return static_cast<uint16_t>(codigo);
+}
+
+DiccionarioTextos& diccionarioNombres() {
+    static DiccionarioTextos diccionario;
+    return diccionario;
+}
+
+DiccionarioTextos& diccionarioApellidos() {
+    static DiccionarioTextos diccionario;
+    return diccionario;
+}
+
+DiccionarioTextos& diccionarioCiudades() {
+    static DiccionarioTextos diccionario(256);
+    return diccionario;
+}
+
+FIN_VARIANTE
@@ -0,0 +1,66 @@
+#ifndef DICCIONARIO_H
+#define DICCIONARIO_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "espacio_variante.h"
+
+INICIO_VARIANTE
+
+/**
+ * Diccionario de textos compartido por todas las personas (internado de strings).
+ *
+ * POR QUÉ: Nombres, apellidos y ciudades salen de unas pocas decenas de valores, pero cada
+ *          Persona guardaba su propia copia de cada texto (32 bytes por std::string más el
+ *          bloque de heap de los largos).
+ * CÓMO: Cada texto distinto se guarda una vez y recibe un código consecutivo; el código 0 es
+ *       siempre el texto vacío. Los textos viven en páginas de 256 que no se mueven nunca, así
+ *       que texto() no bloquea y sus referencias son válidas mientras viva el programa.
+ *       codificar() toma un mutex: se usa al crear personas desde texto, no por fila en los
+ *       recorridos (el generador y la instantánea traducen sus tablas una sola vez).
+ * PARA QUÉ: Personas con códigos de 1-2 bytes; el texto solo se resuelve al mostrarlas.
+ */
+class DiccionarioTextos {
+public:
+    // limite: número máximo de códigos (como mucho 65536)
+    explicit DiccionarioTextos(size_t limite = LIMITE_CODIGOS);
+    ~DiccionarioTextos();
+
+    DiccionarioTextos(const DiccionarioTextos&) = delete;
+    DiccionarioTextos& operator=(const DiccionarioTextos&) = delete;
+
+    // Código del texto (lo agrega si es nuevo). Con el diccionario lleno lanza std::length_error.
+    uint16_t codificar(const std::string& texto);
+
+    // Texto de un código devuelto por codificar()
+    const std::string& texto(uint16_t codigo) const {
+        return paginas[codigo / TAM_PAGINA].load(std::memory_order_acquire)[codigo % TAM_PAGINA];
+    }
+
+    // Códigos asignados hasta ahora (el vacío incluido)
+    size_t tamano() const { return cantidad.load(std::memory_order_acquire); }
+
+    static const size_t LIMITE_CODIGOS = 65536;
+
+private:
+    static const size_t TAM_PAGINA = 256;
+
+    size_t limite;
+    std::atomic<std::string*> paginas[LIMITE_CODIGOS / TAM_PAGINA];
+    std::atomic<size_t> cantidad;
+    std::mutex mutex;
+    std::unordered_map<std::string, uint16_t> codigos;
+};
+
+// Diccionarios de todas las personas del programa
+DiccionarioTextos& diccionarioNombres();
+DiccionarioTextos& diccionarioApellidos();
+DiccionarioTextos& diccionarioCiudades(); // Como mucho 256 códigos (uint8_t en Persona)
+
+FIN_VARIANTE
+
+#endif // DICCIONARIO_H
@@ -0,0 +1,21 @@
+#ifndef ESPACIO_VARIANTE_H
+#define ESPACIO_VARIANTE_H
+
+/**
+ * Espacio de nombres opcional de Persona y de lo que usa (grupos y diccionarios).
+ *
+ * POR QUÉ: comparacion/ enlaza este código junto al de medida_estructura, que define los
+ *          mismos nombres (Persona, edadMasLongevaPais...).
+ * CÓMO: Compilado con -DESPACIO_VARIANTE=clases, todo queda dentro de 'namespace clases';
+ *       sin la macro no cambia nada. Las cabeceras lo abren después de sus #include.
+ * PARA QUÉ: Compilar cada variante como una unidad de traducción normal.
+ */
+#ifdef ESPACIO_VARIANTE
+#define INICIO_VARIANTE namespace ESPACIO_VARIANTE {
+#define FIN_VARIANTE }
+#else
+#define INICIO_VARIANTE
+#define FIN_VARIANTE
+#endif
+
+#endif // ESPACIO_VARIANTE_H
@@ -1,9 +1,13 @@
 #include "generador.h"
+#include "aleatorio.h"
+#include "monitor.h" // TramoPerfil
+#include <atomic>    // std::atomic
+#include <chrono>    // std::chrono::steady_clock
 #include <cstdlib>   // rand(), srand()
 #include <ctime>     // time()
 #include <random>    // std::mt19937, std::uniform_real_distribution
 #include <vector>
-#include <algorithm> // std::find_if
+#include <algorithm> // std::find_if, std::min, std::max
 
 // Bases de datos para generación realista
 
@@ -32,6 +36,42 @@ const std::vector<std::string> ciudadesColombia = {
     "Manizales", "Pasto", "Neiva", "Villavicencio", "Armenia", "Sincelejo", "Valledupar", "Montería", "Popayán", "Tunja"
 };
 
+/**
+ * Códigos de diccionario de las bases de datos anteriores.
+ * 
+ * POR QUÉ: Persona guarda códigos; buscar cada texto en el diccionario por persona
+ *          tomaría su mutex millones de veces.
+ * CÓMO: Cada lista se codifica una sola vez (en la primera persona generada); la posición
+ *       sorteada se traduce con un acceso a un vector.
+ * PARA QUÉ: Generar personas sin copiar textos ni bloquear entre hilos.
+ */
+struct CodigosGenerador {
+    std::vector<uint16_t> femeninos, masculinos, apellidos;
+    std::vector<uint8_t> ciudades;
+};
+
+static std::vector<uint16_t> codificarLista(DiccionarioTextos& diccionario, const std::vector<std::string>& textos) {
+    std::vector<uint16_t> codigos;
+    for (const std::string& texto : textos) {
+        codigos.push_back(diccionario.codificar(texto));
+    }
+    return codigos;
+}
+
+static const CodigosGenerador& codigosGenerador() {
+    static const CodigosGenerador codigos = [] {
+        CodigosGenerador c;
+        c.femeninos = codificarLista(diccionarioNombres(), nombresFemeninos);
+        c.masculinos = codificarLista(diccionarioNombres(), nombresMasculinos);
+        c.apellidos = codificarLista(diccionarioApellidos(), apellidos);
+        for (uint16_t codigo : codificarLista(diccionarioCiudades(), ciudadesColombia)) {
+            c.ciudades.push_back(static_cast<uint8_t>(codigo));
+        }
+        return c;
+    }();
+    return codigos;
+}
+
 /**
  * Implementación de generarFechaNacimiento.
  * 
@@ -53,9 +93,9 @@ std::string generarFechaNacimiento() {
  * CÓMO: Contador estático que inicia en 1000000000 y se incrementa.
  * PARA QUÉ: Simular números de cédula.
  */
-std::string generarID() {
-    static long contador = 1000000000; // Inicia en 1,000,000,000
-    return std::to_string(contador++); // Convierte a string e incrementa
+uint64_t generarID() {
+    static uint64_t contador = ID_INICIAL; // Inicia en 1,000,000,000
+    return contador++;                     // Devuelve e incrementa
 }
 
 /**
@@ -79,22 +119,23 @@ double randomDouble(double min, double max) {
  * PARA QUÉ: Generar datos de prueba.
  */
 Persona generarPersona() {
+    const CodigosGenerador& codigos = codigosGenerador();
+    
     // Decide si es hombre o mujer
     bool esHombre = rand() % 2;
     
     // Selecciona nombre según género
-    std::string nombre = esHombre ? 
-        nombresMasculinos[rand() % nombresMasculinos.size()] :
-        nombresFemeninos[rand() % nombresFemeninos.size()];
+    uint16_t nombre = esHombre ? 
+        codigos.masculinos[rand() % nombresMasculinos.size()] :
+        codigos.femeninos[rand() % nombresFemeninos.size()];
     
-    // Construye apellido compuesto (dos apellidos aleatorios)
-    std::string apellido = apellidos[rand() % apellidos.size()];
-    apellido += " ";
-    apellido += apellidos[rand() % apellidos.size()];
+    // Apellido compuesto (dos apellidos aleatorios)
+    uint16_t apellidoPaterno = codigos.apellidos[rand() % apellidos.size()];
+    uint16_t apellidoMaterno = codigos.apellidos[rand() % apellidos.size()];
     
     // Genera los demás atributos
-    std::string id = generarID();
-    std::string ciudad = ciudadesColombia[rand() % ciudadesColombia.size()];
+    uint64_t id = generarID();
+    uint8_t ciudad = codigos.ciudades[rand() % ciudadesColombia.size()];
     std::string fecha = generarFechaNacimiento();
     
     // Genera datos financieros realistas
@@ -103,7 +144,7 @@ Persona generarPersona() {
     double deudas = randomDouble(0, patrimonio * 0.7);     // Deudas hasta el 70% del patrimonio
     bool declarante = (ingresos > 50000000) && (rand() % 100 > 30); // Probabilidad 70% si ingresos > 50M
     
-    return Persona(nombre, apellido, id, ciudad, fecha, ingresos, patrimonio, deudas, declarante);
+    return Persona(nombre, apellidoPaterno, apellidoMaterno, id, ciudad, fecha, ingresos, patrimonio, deudas, declarante);
 }
 
 /**
@@ -113,8 +154,8 @@ Persona generarPersona() {
  * CÓMO: Reservando espacio y agregando n personas generadas.
  * PARA QUÉ: Crear datasets para pruebas.
  */
-std::vector<Persona> generarColeccion(int n) {
-    std::vector<Persona> personas;
+ColeccionPersonas generarColeccion(int n) {
+    ColeccionPersonas personas;
     personas.reserve(n); // Reserva espacio para n personas (eficiencia)
     
     for (int i = 0; i < n; ++i) {
@@ -124,6 +165,187 @@ std::vector<Persona> generarColeccion(int n) {
     return personas;
 }
 
+uint64_t semillaAleatoria() {
+    std::random_device dispositivo;
+    uint64_t semilla = (static_cast<uint64_t>(dispositivo()) << 32) ^ dispositivo();
+    semilla ^= static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return semilla != 0 ? semilla : 1;
+}
+
+// Valores sorteados para la persona i de una semilla (posiciones en las listas, sin textos)
+struct SorteoPersona {
+    uint16_t nombre;          // Código de diccionario
+    uint16_t apellidoPaterno;
+    uint16_t apellidoMaterno;
+    uint8_t ciudad;           // Posición en ciudadesColombia (código de la tabla)
+    int dia, mes, anio;
+    double ingresos, patrimonio, deudas;
+    bool declarante;
+};
+
+/**
+ * Sorteos de la persona i de una semilla.
+ * 
+ * POR QUÉ: La persona completa y las columnas analíticas deben salir de los mismos sorteos.
+ * CÓMO: Mismo orden de sorteos que generarPersona(), con el flujo (semilla, i).
+ * PARA QUÉ: Única definición de la persona i para generarPersonaSemilla y generarFilasColumnas.
+ */
+static inline SorteoPersona sortearPersona(const CodigosGenerador& codigos, uint64_t semilla, uint64_t i) {
+    GeneradorContador aleatorio(semilla, i);
+    SorteoPersona s;
+
+    bool esHombre = aleatorio.entero(2);
+    s.nombre = esHombre ?
+        codigos.masculinos[aleatorio.entero(nombresMasculinos.size())] :
+        codigos.femeninos[aleatorio.entero(nombresFemeninos.size())];
+
+    s.apellidoPaterno = codigos.apellidos[aleatorio.entero(apellidos.size())];
+    s.apellidoMaterno = codigos.apellidos[aleatorio.entero(apellidos.size())];
+
+    s.ciudad = static_cast<uint8_t>(aleatorio.entero(ciudadesColombia.size()));
+
+    s.dia = 1 + aleatorio.entero(28);
+    s.mes = 1 + aleatorio.entero(12);
+    s.anio = 1960 + aleatorio.entero(50);
+
+    s.ingresos = aleatorio.real(10000000, 500000000);
+    s.patrimonio = aleatorio.real(0, 2000000000);
+    s.deudas = aleatorio.real(0, s.patrimonio * 0.7);
+    s.declarante = (s.ingresos > 50000000) && (aleatorio.entero(100) > 30);
+    return s;
+}
+
+/**
+ * Crea la persona i de una semilla y devuelve también el código de su ciudad.
+ * 
+ * POR QUÉ: La tabla necesita el código de ciudad y ya se conoce al sortearla.
+ * CÓMO: sortearPersona más el texto de la fecha; el ID es ID_INICIAL + i.
+ * PARA QUÉ: Base de generarPersona(semilla, i) y de la generación paralela.
+ */
+static Persona generarPersonaSemilla(uint64_t semilla, uint64_t i, uint8_t& codigoCiudad) {
+    const CodigosGenerador& codigos = codigosGenerador();
+    const SorteoPersona s = sortearPersona(codigos, semilla, i);
+    codigoCiudad = s.ciudad;
+    std::string fecha = std::to_string(s.dia) + "/" + std::to_string(s.mes) + "/" + std::to_string(s.anio);
+    return Persona(s.nombre, s.apellidoPaterno, s.apellidoMaterno, ID_INICIAL + i, codigos.ciudades[s.ciudad], fecha,
+                   s.ingresos, s.patrimonio, s.deudas, s.declarante);
+}
+
+Persona generarPersona(uint64_t semilla, uint64_t i) {
+    uint8_t codigoCiudad;
+    return generarPersonaSemilla(semilla, i, codigoCiudad);
+}
+
+/**
+ * Llena 'personas' y 'tabla' (ya dimensionadas) con las filas globales [primeraFila, primeraFila + n).
+ * 
+ * POR QUÉ: La generación completa y la de cada lote solo difieren en la primera fila.
+ * CÓMO: Un contador atómico entrega tramos de filas locales a los hilos del pool; cada fila
+ *       depende solo de (semilla, fila global) y se escribe en su propia posición, y los tramos
+ *       alineados a 64 filas no comparten palabras del bitset de declarantes.
+ * PARA QUÉ: Base de generarColeccion paralela y de generarPorLotes.
+ */
+static void generarFilas(uint64_t primeraFila, size_t n, uint64_t semilla, ColeccionPersonas& personas,
+                         TablaPersonas& tabla, PoolHilos& pool) {
+    const size_t numTramos = (n + TAM_TRAMO_GENERACION - 1) / TAM_TRAMO_GENERACION;
+    std::atomic<size_t> siguienteTramo(0);
+
+    pool.ejecutar([&](size_t) {
+        for (size_t tramo = siguienteTramo++; tramo < numTramos; tramo = siguienteTramo++) {
+            size_t inicio = tramo * TAM_TRAMO_GENERACION;
+            size_t fin = std::min(n, inicio + TAM_TRAMO_GENERACION);
+            for (size_t i = inicio; i < fin; ++i) {
+                uint8_t codigoCiudad;
+                personas[i] = generarPersonaSemilla(semilla, primeraFila + i, codigoCiudad);
+                tabla.asignar(i, personas[i], codigoCiudad);
+            }
+        }
+    });
+}
+
+/**
+ * Implementación de generarColeccion paralela.
+ * 
+ * POR QUÉ: Repartir la generación entre núcleos sin que el resultado dependa del reparto.
+ * CÓMO: Vector y tabla se dimensionan antes y generarFilas los llena desde la fila 0.
+ * PARA QUÉ: Generación escalable y reproducible.
+ */
+ColeccionPersonas generarColeccion(size_t n, uint64_t semilla, TablaPersonas& tabla, PoolHilos& pool,
+                                   std::pmr::memory_resource* recurso) {
+    TramoPerfil tramo("generar");
+    ColeccionPersonas personas(n, recurso);
+    tabla.preparar(n, ciudadesColombia);
+    generarFilas(0, n, semilla, personas, tabla, pool);
+    return personas;
+}
+
+/**
+ * Implementación de generarFilasColumnas.
+ * 
+ * POR QUÉ: Para analizar no hace falta la Persona (strings, diccionarios), solo sus números.
+ * CÓMO: Como generarFilas, pero cada fila escribe en la tabla los valores de sortearPersona;
+ *       la fecha se empaqueta con aritmética y el calendario sale del ID.
+ * PARA QUÉ: Recorrer conjuntos virtuales sin construir ni destruir una Persona por fila.
+ */
+void generarFilasColumnas(uint64_t primeraFila, size_t n, uint64_t semilla, TablaPersonas& tabla, PoolHilos& pool) {
+    TramoPerfil tramo("generar columnas");
+    const CodigosGenerador& codigos = codigosGenerador();
+    tabla.preparar(n, ciudadesColombia);
+
+    const size_t numTramos = (n + TAM_TRAMO_GENERACION - 1) / TAM_TRAMO_GENERACION;
+    std::atomic<size_t> siguienteTramo(0);
+
+    pool.ejecutar([&](size_t) {
+        for (size_t tramo = siguienteTramo++; tramo < numTramos; tramo = siguienteTramo++) {
+            size_t inicio = tramo * TAM_TRAMO_GENERACION;
+            size_t fin = std::min(n, inicio + TAM_TRAMO_GENERACION);
+            for (size_t i = inicio; i < fin; ++i) {
+                const uint64_t fila = primeraFila + i;
+                const SorteoPersona s = sortearPersona(codigos, semilla, fila);
+                tabla.asignarValores(i, s.ingresos, s.patrimonio, s.deudas, Persona::empaquetarFecha(s.dia, s.mes, s.anio),
+                                     s.ciudad, static_cast<uint8_t>(Persona::calendarioDeId(ID_INICIAL + fila) - 'A'),
+                                     s.declarante);
+            }
+        }
+    });
+}
+
+const std::vector<std::string>& ciudadesGenerador() {
+    return ciudadesColombia;
+}
+
+/**
+ * Implementación de generarPorLotes.
+ * 
+ * POR QUÉ: Recorrer conjuntos que no caben en memoria.
+ * CÓMO: El vector y las columnas del lote conservan su capacidad entre lotes (preparar solo
+ *       redimensiona), así que tras el primer lote no se reserva memoria nueva.
+ * PARA QUÉ: Memoria acotada por tamLote, no por n.
+ */
+uint64_t generarPorLotes(uint64_t n, uint64_t semilla, size_t tamLote, PoolHilos& pool,
+                         const SumideroLotes& sumidero) {
+    tamLote = std::max<size_t>(64, (tamLote + 63) / 64 * 64);
+    LotePersonas lote;
+    lote.personas.reserve(static_cast<size_t>(std::min<uint64_t>(n, tamLote)));
+
+    uint64_t entregadas = 0;
+    while (entregadas < n) {
+        const size_t filas = static_cast<size_t>(std::min<uint64_t>(n - entregadas, tamLote));
+        {
+            TramoPerfil tramo("generar lote");
+            lote.primeraFila = entregadas;
+            lote.personas.resize(filas);
+            lote.tabla.preparar(filas, ciudadesColombia);
+            generarFilas(entregadas, filas, semilla, lote.personas, lote.tabla, pool);
+        }
+        if (!sumidero(lote)) {
+            break;
+        }
+        entregadas += filas;
+    }
+    return entregadas;
+}
+
 /**
  * Implementación de buscarPorID.
  * 
@@ -131,14 +353,81 @@ std::vector<Persona> generarColeccion(int n) {
  * CÓMO: Usando un algoritmo de búsqueda secuencial (lineal).
  * PARA QUÉ: Para operaciones de búsqueda en la aplicación.
  */
-const Persona* buscarPorID(const std::vector<Persona>& personas, const std::string& id) {
+const Persona* buscarPorID(const ColeccionPersonas& personas, uint64_t id) {
     // Usa find_if con una lambda para buscar por ID
     auto it = std::find_if(personas.begin(), personas.end(),
-        [&id](const Persona& p) { return p.getId() == id; });
+        [id](const Persona& p) { return p.getId() == id; });
     
     if (it != personas.end()) {
         return &(*it); // Devuelve puntero a la persona encontrada
     } else {
         return nullptr; // No encontrado
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Implementación de convertirID.
+ * 
+ * POR QUÉ: La opción de búsqueda lee el ID como texto.
+ * CÓMO: Acepta solo dígitos (como máximo 19, caben en 64 bits).
+ * PARA QUÉ: Validar la entrada una vez y no convertir IDs en cada comparación.
+ */
+bool convertirID(const std::string& texto, uint64_t& id) {
+    if (texto.empty() || texto.size() > 19) {
+        return false;
+    }
+    uint64_t valor = 0;
+    for (char c : texto) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        valor = valor * 10 + static_cast<uint64_t>(c - '0');
+    }
+    id = valor;
+    return true;
+}
+
+// Implementación de buscarPorID con ID en texto: convierte y delega en la búsqueda numérica
+const Persona* buscarPorID(const ColeccionPersonas& personas, const std::string& id) {
+    uint64_t valor;
+    if (!convertirID(id, valor)) {
+        return nullptr;
+    }
+    return buscarPorID(personas, valor);
+}
+
+/**
+ * Implementación de buscarPorID con índice.
+ * 
+ * POR QUÉ: Evitar el recorrido lineal de la colección.
+ * CÓMO: El índice devuelve la fila; se comprueba que siga dentro de la colección.
+ * PARA QUÉ: Búsqueda O(1) en la opción 3 del menú.
+ */
+const Persona* buscarPorID(const ColeccionPersonas& personas, const IndiceID& indice, uint64_t id) {
+    size_t fila = indice.buscar(id);
+    if (fila == IndiceID::NO_ENCONTRADO || fila >= personas.size()) {
+        return nullptr;
+    }
+    return &personas[fila];
+}
+
+/**
+ * Implementación de buscarPorIDs.
+ * 
+ * POR QUÉ: Resolver muchos IDs con una sola pasada por el índice.
+ * CÓMO: IndiceID::buscarLote llena las filas y luego se traducen a punteros.
+ * PARA QUÉ: Consultas masivas con los fallos de caché solapados.
+ */
+std::vector<const Persona*> buscarPorIDs(const ColeccionPersonas& personas, const IndiceID& indice,
+                                         const std::vector<uint64_t>& ids) {
+    std::vector<size_t> filas(ids.size());
+    indice.buscarLote(ids.data(), ids.size(), filas.data());
+
+    std::vector<const Persona*> resultado(ids.size(), nullptr);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (filas[i] != IndiceID::NO_ENCONTRADO && filas[i] < personas.size()) {
+            resultado[i] = &personas[filas[i]];
+        }
+    }
+    return resultado;
+}
@@ -2,6 +2,10 @@
 #define GENERADOR_H
 
 #include "persona.h"
+#include "tabla.h"
+#include "indice.h"
+#include "hilos.h"
+#include <functional>
 #include <vector>
 
 // Funciones para generación de datos aleatorios
@@ -15,14 +19,17 @@
  */
 std::string generarFechaNacimiento();
 
+// Primer ID de los conjuntos generados (la fila i de una semilla tiene el ID ID_INICIAL + i)
+const uint64_t ID_INICIAL = 1000000000;
+
 /**
  * Genera un ID único secuencial.
  * 
  * POR QUÉ: Necesidad de identificadores únicos para cada persona.
  * CÓMO: Usando un contador estático que incrementa en cada llamada.
- * PARA QUÉ: Garantizar unicidad en los IDs.
+ * PARA QUÉ: Garantizar unicidad en los IDs (numéricos; solo se convierten a texto al mostrarlos).
  */
-std::string generarID();
+uint64_t generarID();
 
 /**
  * Genera un número decimal aleatorio en un rango [min, max].
@@ -49,7 +56,95 @@ Persona generarPersona();
  * CÓMO: Llamando a generarPersona() n veces.
  * PARA QUÉ: Pruebas de rendimiento y funcionalidad con volúmenes variables.
  */
-std::vector<Persona> generarColeccion(int n);
+ColeccionPersonas generarColeccion(int n);
+
+// Filas por tramo en la generación paralela (múltiplo de 64: un tramo no comparte palabras del bitset)
+const size_t TAM_TRAMO_GENERACION = 4096;
+
+/**
+ * Devuelve una semilla nueva para cuando el usuario no indica ninguna.
+ * 
+ * POR QUÉ: La semilla 0 significa "aleatoria" en el menú.
+ * CÓMO: std::random_device mezclado con el reloj.
+ * PARA QUÉ: Conjuntos distintos por defecto; la semilla se muestra para poder repetirlos.
+ */
+uint64_t semillaAleatoria();
+
+/**
+ * Crea la persona número i del conjunto de datos de una semilla.
+ * 
+ * POR QUÉ: Generación reproducible e independiente del orden y del número de hilos.
+ * CÓMO: Un GeneradorContador propio para (semilla, i); mismas distribuciones que generarPersona().
+ *       El ID es 1000000000 + i.
+ * PARA QUÉ: Que cualquier hilo pueda generar cualquier fila sin estado compartido.
+ */
+Persona generarPersona(uint64_t semilla, uint64_t i);
+
+/**
+ * Genera n personas en paralelo a partir de una semilla y llena su tabla columnar.
+ * 
+ * POR QUÉ: La generación secuencial con rand() no escala ni se puede repetir.
+ * CÓMO: Los hilos del pool toman tramos de TAM_TRAMO_GENERACION filas y escriben cada persona
+ *       en su posición del vector y de la tabla (preparados de antemano).
+ * PARA QUÉ: Conjuntos de decenas de millones de personas, idénticos para la misma semilla
+ *           con cualquier número de hilos (benchmarks repetibles).
+ * 
+ * @param n Número de personas a generar.
+ * @param semilla Semilla del conjunto de datos.
+ * @param tabla Tabla que se llena; la fila i corresponde al elemento i del vector.
+ * @param pool Hilos que reparten la generación.
+ * @param recurso Memoria de la colección (p. ej. la Arena de la sesión); por defecto, el heap.
+ */
+ColeccionPersonas generarColeccion(size_t n, uint64_t semilla, TablaPersonas& tabla, PoolHilos& pool,
+                                   std::pmr::memory_resource* recurso = std::pmr::get_default_resource());
+
+/**
+ * Lote de personas entregado por generarPorLotes.
+ * 
+ * POR QUÉ: Un conjunto de mil millones de personas no cabe en memoria como un solo vector.
+ * CÓMO: Las personas y su tabla columnar ocupan las filas locales 0..tamaño-1; la persona
+ *       local j es la fila global primeraFila + j (y su ID, 1000000000 + primeraFila + j).
+ * PARA QUÉ: Que agregador, listados e instantáneas consuman los datos mientras se generan.
+ */
+struct LotePersonas {
+    uint64_t primeraFila = 0;
+    ColeccionPersonas personas;
+    TablaPersonas tabla;
+};
+
+// Consumidor de lotes: devuelve false para detener la generación (p. ej. tras un error de escritura)
+using SumideroLotes = std::function<bool(const LotePersonas& lote)>;
+
+// Ciudades del generador en orden de código (el mismo que usa la tabla de cada lote)
+const std::vector<std::string>& ciudadesGenerador();
+
+/**
+ * Llena una tabla con las columnas analíticas de las filas [primeraFila, primeraFila + n) de una semilla.
+ * 
+ * POR QUÉ: Las agregaciones sobre conjuntos enormes solo leen números; crear la Persona de
+ *          cada fila (fecha en texto, códigos de nombre y apellido) es trabajo perdido.
+ * CÓMO: Los mismos sorteos que generarPersona(semilla, i), escritos directamente en la tabla
+ *       (preparada con ciudadesGenerador()) por los hilos del pool.
+ * PARA QUÉ: Columnas idénticas a las de generarColeccion para la misma semilla, sin personas.
+ */
+void generarFilasColumnas(uint64_t primeraFila, size_t n, uint64_t semilla, TablaPersonas& tabla, PoolHilos& pool);
+
+/**
+ * Genera n personas de una semilla por lotes de tamaño fijo y entrega cada lote a un sumidero.
+ * 
+ * POR QUÉ: generarColeccion materializa todo el conjunto antes de poder usarlo, así que n
+ *          queda limitado por la memoria.
+ * CÓMO: Un único LotePersonas se reutiliza: cada lote se genera en paralelo como en
+ *       generarColeccion (la fila global i sale de (semilla, i)) y se pasa al sumidero antes
+ *       de generar el siguiente. El tamaño del lote se redondea a un múltiplo de 64 para que
+ *       cada lote empiece en una palabra nueva del bitset de declarantes.
+ * PARA QUÉ: Estadísticas, listados e instantáneas de conjuntos arbitrariamente grandes con
+ *           memoria acotada por el tamaño del lote; mismos datos que generarColeccion(n, semilla).
+ * 
+ * @return Filas entregadas al sumidero (menos que n si este pidió detenerse).
+ */
+uint64_t generarPorLotes(uint64_t n, uint64_t semilla, size_t tamLote, PoolHilos& pool,
+                         const SumideroLotes& sumidero);
 
 /**
  * Busca una persona por ID en un vector de personas.
@@ -62,6 +157,47 @@ std::vector<Persona> generarColeccion(int n);
  * @param id ID a buscar.
  * @return Puntero a la persona encontrada o nullptr si no se encuentra.
  */
-const Persona* buscarPorID(const std::vector<Persona>& personas, const std::string& id);
+const Persona* buscarPorID(const ColeccionPersonas& personas, uint64_t id);
+
+/**
+ * Convierte un ID escrito como texto en su valor numérico.
+ * 
+ * POR QUÉ: Los IDs se leen como texto pero se guardan como uint64_t.
+ * CÓMO: Acepta solo dígitos (como máximo 19, caben en 64 bits).
+ * PARA QUÉ: Validar la entrada una sola vez antes de buscar.
+ * @return true si el texto es un ID válido (y lo deja en 'id').
+ */
+bool convertirID(const std::string& texto, uint64_t& id);
+
+/**
+ * Busca una persona por un ID escrito como texto (p. ej. leído de la consola).
+ * 
+ * POR QUÉ: Los usuarios escriben el ID, pero la colección guarda IDs numéricos.
+ * CÓMO: Convirtiendo el texto una sola vez y delegando en la búsqueda numérica.
+ * PARA QUÉ: Comparar enteros en lugar de strings durante la búsqueda.
+ * @return Puntero a la persona encontrada o nullptr si no se encuentra o el texto no es un ID.
+ */
+const Persona* buscarPorID(const ColeccionPersonas& personas, const std::string& id);
+
+/**
+ * Busca una persona por ID usando el índice hash de la colección.
+ * 
+ * POR QUÉ: La búsqueda lineal es O(n) por consulta.
+ * CÓMO: Consultando el IndiceID construido para 'personas'.
+ * PARA QUÉ: Búsquedas O(1) en colecciones de millones de personas.
+ * @return Puntero a la persona encontrada o nullptr si no se encuentra.
+ */
+const Persona* buscarPorID(const ColeccionPersonas& personas, const IndiceID& indice, uint64_t id);
+
+/**
+ * Busca muchas personas por ID en una sola llamada.
+ * 
+ * POR QUÉ: Las consultas masivas pagan un fallo de caché por ID si se hacen una a una.
+ * CÓMO: Usando IndiceID::buscarLote, que precarga las ranuras por grupos.
+ * PARA QUÉ: Resolver listas de IDs (p. ej. cruces con otros datos) en bloque.
+ * @return Un puntero por ID, en el mismo orden (nullptr para los no encontrados).
+ */
+std::vector<const Persona*> buscarPorIDs(const ColeccionPersonas& personas, const IndiceID& indice,
+                                         const std::vector<uint64_t>& ids);
 
 #endif // GENERADOR_H
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "grupos.h"
+#include <algorithm> // std::sort
+#include <numeric>   // std::iota
+
+INICIO_VARIANTE
+
+/**
+ * Implementación de construirVista.
+ *
+ * POR QUÉ: Agrupar sin copiar personas ni crear un vector por grupo.
+ * CÓMO: 1) orden alfabético de las claves, 2) conteo por código, 3) suma prefija,
+ *       4) reparto estable de las filas.
+ * PARA QUÉ: Base común de las agrupaciones por ciudad, calendario y declarantes.
+ */
+void construirVista(const std::vector<std::string>& claves, const std::vector<uint32_t>& codigos, VistaGrupos& vista) {
+    // Orden alfabético de los códigos, igual que el de las claves de un std::map
+    std::vector<uint32_t> orden(claves.size());
+    std::iota(orden.begin(), orden.end(), 0u);
+    std::sort(orden.begin(), orden.end(), [&claves](uint32_t a, uint32_t b) {
+        return claves[a] < claves[b];
+    });
+
+    std::vector<uint32_t> conteo(claves.size(), 0);
+    for (uint32_t codigo : codigos) {
+        if (codigo != FILA_EXCLUIDA) {
+            conteo[codigo]++;
+        }
+    }
+
+    // Posición de inicio de cada código en 'filas'; los grupos vacíos no generan clave
+    vista.limpiar();
+    std::vector<uint32_t> siguiente(claves.size(), 0);
+    uint32_t total = 0;
+    for (uint32_t codigo : orden) {
+        if (conteo[codigo] == 0) {
+            continue;
+        }
+        vista.claves.push_back(claves[codigo]);
+        vista.inicios.push_back(total);
+        siguiente[codigo] = total;
+        total += conteo[codigo];
+    }
+    vista.inicios.push_back(total);
+
+    vista.filas.resize(total);
+    for (size_t fila = 0; fila < codigos.size(); ++fila) {
+        if (codigos[fila] != FILA_EXCLUIDA) {
+            vista.filas[siguiente[codigos[fila]]++] = static_cast<uint32_t>(fila);
+        }
+    }
+}
+
+FIN_VARIANTE
@@ -0,0 +1,74 @@
+#ifndef GRUPOS_H
+#define GRUPOS_H
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include "espacio_variante.h"
+
+INICIO_VARIANTE
+
+/**
+ * Vista de agrupación: qué filas de la colección pertenecen a cada grupo.
+ *
+ * POR QUÉ: Agrupar en std::map<std::string, std::vector<Persona>> copia cada persona
+ *          (cinco strings) y duplica la memoria del conjunto de datos.
+ * CÓMO: Formato CSR: las filas de todos los grupos van seguidas en 'filas' y el grupo g
+ *       ocupa el tramo [inicios[g], inicios[g + 1]). Solo se guardan índices de 4 bytes.
+ *       Los vectores son pmr: la vista puede vivir en una Arena (arena.h) de la operación.
+ * PARA QUÉ: Agrupar millones de personas sin duplicarlas; las funciones que reciben la vista
+ *           leen los datos de la colección original.
+ */
+struct VistaGrupos {
+    // Tramo de filas de un grupo, recorrible con for-range
+    struct RangoFilas {
+        const uint32_t* inicio;
+        const uint32_t* fin;
+        const uint32_t* begin() const { return inicio; }
+        const uint32_t* end() const { return fin; }
+        size_t size() const { return static_cast<size_t>(fin - inicio); }
+        bool empty() const { return inicio == fin; }
+    };
+
+    std::pmr::vector<std::string> claves; // Nombre de cada grupo, en orden alfabético (como std::map)
+    std::pmr::vector<uint32_t> inicios;   // numGrupos() + 1 posiciones dentro de 'filas'
+    std::pmr::vector<uint32_t> filas;     // Índices en la colección original, agrupados
+
+    explicit VistaGrupos(std::pmr::memory_resource* recurso = std::pmr::get_default_resource())
+        : claves(recurso), inicios(recurso), filas(recurso) {}
+
+    size_t numGrupos() const { return claves.size(); }
+
+    RangoFilas grupo(size_t g) const {
+        return RangoFilas{filas.data() + inicios[g], filas.data() + inicios[g + 1]};
+    }
+
+    void limpiar() {
+        claves.clear();
+        inicios.clear();
+        filas.clear();
+    }
+};
+
+// Código que excluye una fila al construir una vista (p. ej. no declarantes)
+const uint32_t FILA_EXCLUIDA = UINT32_MAX;
+
+/**
+ * Construye una vista a partir del código de grupo de cada fila.
+ *
+ * POR QUÉ: Todas las agrupaciones (ciudad, calendario, declarantes) comparten el mismo armado.
+ * CÓMO: Ordenamiento por conteo: cuenta filas por código, calcula los inicios y reparte las
+ *       filas manteniendo su orden original dentro de cada grupo. Las claves se ordenan
+ *       alfabéticamente y se descartan los grupos vacíos.
+ * PARA QUÉ: Vistas en O(n) con una sola reserva de memoria para las filas.
+ *
+ * @param claves Nombre de cada código (codigos[i] indexa este vector).
+ * @param codigos Código de grupo por fila; FILA_EXCLUIDA deja la fila fuera de la vista.
+ * @param vista Vista de salida (se sobrescribe).
+ */
+void construirVista(const std::vector<std::string>& claves, const std::vector<uint32_t>& codigos, VistaGrupos& vista);
+
+FIN_VARIANTE
+
+#endif // GRUPOS_H
@@ -0,0 +1,91 @@
+#include "hilos.h"
+#include "monitor.h" // TramoPerfil
+
+size_t PoolHilos::hilosDisponibles() {
+    unsigned int hilos = std::thread::hardware_concurrency();
+    return hilos > 0 ? hilos : 1;
+}
+
+PoolHilos::PoolHilos(size_t numHilos) {
+    if (numHilos == 0) {
+        numHilos = hilosDisponibles();
+    }
+    // El hilo llamante también trabaja: se crean numHilos - 1 trabajadores
+    trabajadores.reserve(numHilos - 1);
+    for (size_t hilo = 1; hilo < numHilos; ++hilo) {
+        trabajadores.emplace_back(&PoolHilos::bucleTrabajador, this, hilo);
+    }
+}
+
+PoolHilos::~PoolHilos() {
+    {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        detener = true;
+    }
+    hayTarea.notify_all();
+    for (std::thread& trabajador : trabajadores) {
+        trabajador.join();
+    }
+}
+
+/**
+ * Implementación de ejecutar.
+ *
+ * POR QUÉ: Sincronizar una tarea con todos los hilos sin recrearlos.
+ * CÓMO: Publica la tarea con una nueva generación, ejecuta la parte 0 y espera a que
+ *       'pendientes' llegue a cero.
+ * PARA QUÉ: Que el llamante vea los resultados de todos los hilos al volver.
+ */
+void PoolHilos::ejecutar(const std::function<void(size_t hilo)>& tarea) {
+    if (trabajadores.empty()) {
+        TramoPerfil tramo("tarea del pool");
+        tarea(0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        tareaActual = &tarea;
+        monitorTarea = Monitor::activo();
+        pendientes = trabajadores.size();
+        generacion++;
+    }
+    hayTarea.notify_all();
+
+    {
+        TramoPerfil tramo("tarea del pool");
+        tarea(0);
+    }
+
+    std::unique_lock<std::mutex> bloqueo(mutex);
+    tareaTerminada.wait(bloqueo, [this] { return pendientes == 0; });
+    tareaActual = nullptr;
+}
+
+// Espera tareas nuevas hasta que el pool se destruye
+void PoolHilos::bucleTrabajador(size_t hilo) {
+    size_t vista = 0;
+    while (true) {
+        const std::function<void(size_t)>* tarea;
+        Monitor* monitor;
+        {
+            std::unique_lock<std::mutex> bloqueo(mutex);
+            hayTarea.wait(bloqueo, [this, vista] { return detener || generacion != vista; });
+            if (detener) {
+                return;
+            }
+            vista = generacion;
+            tarea = tareaActual;
+            monitor = monitorTarea;
+        }
+
+        {
+            TramoPerfil tramo(monitor, "tarea del pool"); // Raíz del trabajador (nada sin monitor)
+            (*tarea)(hilo);
+        }
+
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        if (--pendientes == 0) {
+            tareaTerminada.notify_one();
+        }
+    }
+}
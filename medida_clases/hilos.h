@@ -0,0 +1,63 @@
+#ifndef HILOS_H
+#define HILOS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Monitor;
+
+/**
+ * Pool de hilos de trabajo persistentes.
+ *
+ * POR QUÉ: Crear y destruir hilos en cada análisis cuesta más que el propio recorrido
+ *          en conjuntos pequeños.
+ * CÓMO: Los hilos se crean una vez y esperan en una variable de condición; ejecutar()
+ *       publica una tarea, la reparte por índice de hilo y espera a que todos terminen.
+ * PARA QUÉ: Repartir el recorrido de la colección entre núcleos con un número de hilos
+ *           elegido en tiempo de ejecución.
+ */
+class PoolHilos {
+public:
+    // numHilos = 0 usa std::thread::hardware_concurrency()
+    explicit PoolHilos(size_t numHilos = 0);
+    ~PoolHilos();
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    size_t numHilos() const { return trabajadores.size() + 1; }
+
+    /**
+     * Ejecuta tarea(hilo) para cada hilo del pool y espera a que terminen todos.
+     *
+     * POR QUÉ: El reparto estático (un tramo contiguo por hilo) mantiene el orden de filas
+     *          entre hilos, necesario para que los resultados coincidan con el secuencial.
+     * CÓMO: El hilo llamante ejecuta la parte 0; los trabajadores, las partes 1..numHilos()-1.
+     *       Si el llamante tiene un monitor activo, cada parte es un tramo "tarea del pool" en la
+     *       traza del hilo que la ejecuta.
+     * PARA QUÉ: Base de las versiones paralelas del análisis.
+     */
+    void ejecutar(const std::function<void(size_t hilo)>& tarea);
+
+    // Número de hilos por defecto de la máquina (al menos 1)
+    static size_t hilosDisponibles();
+
+private:
+    void bucleTrabajador(size_t hilo);
+
+    std::vector<std::thread> trabajadores;
+    std::mutex mutex;
+    std::condition_variable hayTarea;
+    std::condition_variable tareaTerminada;
+    const std::function<void(size_t)>* tareaActual = nullptr;
+    Monitor* monitorTarea = nullptr; // Monitor activo del llamante durante la tarea
+    size_t generacion = 0;  // Cambia con cada tarea publicada
+    size_t pendientes = 0;  // Trabajadores que aún no terminan la tarea actual
+    bool detener = false;
+};
+
+#endif // HILOS_H
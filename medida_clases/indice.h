@@ -0,0 +1,81 @@
+#ifndef INDICE_H
+#define INDICE_H
+
+#include "persona.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Índice hash de IDs numéricos a filas de la colección.
+ *
+ * POR QUÉ: buscarPorID recorre linealmente millones de personas en cada consulta.
+ * CÓMO: Tabla de direccionamiento abierto (sondeo lineal) con ranuras {clave, fila} de 16 bytes,
+ *       capacidad potencia de 2 y factor de carga máximo de 1/2.
+ * PARA QUÉ: Búsquedas por ID en O(1) esperado, individuales o por lotes.
+ */
+class IndiceID {
+public:
+    // Valor devuelto cuando el ID no está en el índice
+    static const size_t NO_ENCONTRADO = SIZE_MAX;
+
+    /**
+     * Construye el índice para una colección (descarta el contenido anterior).
+     *
+     * POR QUÉ: El índice debe reconstruirse cada vez que se genera un conjunto nuevo.
+     * CÓMO: Reservando 2n ranuras (redondeado a potencia de 2) e insertando cada ID con su fila.
+     * PARA QUÉ: Preparar las búsquedas O(1) justo después de generarColeccion.
+     */
+    void construir(const ColeccionPersonas& personas);
+
+    // Elimina todas las entradas
+    void limpiar();
+
+    size_t tamano() const { return elementos; }
+
+    /**
+     * Busca la fila de un ID.
+     * @return Índice de la persona en la colección, o NO_ENCONTRADO.
+     */
+    size_t buscar(uint64_t id) const;
+
+    /**
+     * Busca muchos IDs en una sola llamada.
+     *
+     * POR QUÉ: Con millones de ranuras cada sondeo es casi siempre un fallo de caché.
+     * CÓMO: Procesa los IDs en grupos: primero calcula el hash de todo el grupo y precarga
+     *       (__builtin_prefetch) sus ranuras, luego sondea; así los fallos se solapan.
+     * PARA QUÉ: Consultas masivas limitadas por ancho de banda y no por latencia.
+     * @param ids Arreglo de n IDs a buscar.
+     * @param filas Arreglo de n posiciones donde se escribe la fila de cada ID (o NO_ENCONTRADO).
+     */
+    void buscarLote(const uint64_t* ids, size_t n, size_t* filas) const;
+
+private:
+    // Ranura de la tabla: cuatro por línea de caché
+    struct Ranura {
+        uint64_t clave; // ID, o VACIA
+        uint64_t fila;  // Posición en la colección
+    };
+
+    static const uint64_t VACIA = UINT64_MAX;
+    static const size_t TAM_GRUPO_LOTE = 16;
+
+    // Mezcla de bits (finalizador de MurmurHash3) para repartir IDs consecutivos
+    static uint64_t mezclar(uint64_t clave) {
+        clave ^= clave >> 33;
+        clave *= 0xff51afd7ed558ccdULL;
+        clave ^= clave >> 33;
+        clave *= 0xc4ceb9fe1a85ec53ULL;
+        clave ^= clave >> 33;
+        return clave;
+    }
+
+    // Sondeo lineal a partir de una posición inicial
+    size_t sondear(uint64_t id, size_t posicion) const;
+
+    std::vector<Ranura> ranuras;
+    size_t mascara = 0;   // capacidad - 1
+    size_t elementos = 0;
+};
+
+#endif // INDICE_H
@@ -0,0 +1,633 @@
+#include "instantanea.h"
+#include "monitor.h"     // TramoPerfil
+#include <algorithm>     // std::min
+#include <atomic>        // std::atomic
+#include <cerrno>        // errno, EINTR
+#include <cstring>       // std::memcpy, std::memcmp
+#include <fstream>       // std::ofstream
+#include <stdexcept>     // std::length_error
+#include <unordered_map> // Construcción de diccionarios
+#include <utility>       // std::move
+#include <fcntl.h>       // open
+#include <sys/mman.h>    // mmap, munmap
+#include <sys/stat.h>    // fstat
+#include <unistd.h>      // close, pwrite, ftruncate
+
+// Secciones del archivo, en el orden en que se escriben
+enum SeccionInstantanea {
+    DICC_NOMBRES, DICC_APELLIDOS, DICC_CIUDADES,
+    COL_ID, COL_INGRESOS, COL_PATRIMONIO, COL_DEUDAS, COL_FECHA,
+    COL_NOMBRE, COL_APELLIDO, COL_CIUDAD, COL_CALENDARIO, COL_DECLARANTE,
+    NUM_SECCIONES
+};
+
+// Cabecera al inicio del archivo
+struct CabeceraInstantanea {
+    char magia[8];        // "PERSNAP"
+    uint32_t version;
+    uint32_t marcaOrden;  // MARCA_ORDEN escrita en el orden de bytes de la máquina
+    uint64_t filas;
+    uint64_t bytesArchivo;
+    struct {
+        uint64_t desplazamiento; // Desde el inicio del archivo, múltiplo de ALINEACION
+        uint64_t bytes;
+    } secciones[NUM_SECCIONES];
+};
+
+static const char MAGIA[8] = {'P', 'E', 'R', 'S', 'N', 'A', 'P', '\0'};
+static const uint32_t VERSION_INSTANTANEA = 1;
+static const uint32_t MARCA_ORDEN = 0x01020304;
+static const uint64_t ALINEACION = 64;
+
+static uint64_t alinear(uint64_t valor) {
+    return (valor + ALINEACION - 1) / ALINEACION * ALINEACION;
+}
+
+// Texto "D/M/AAAA" de una fecha AAAAMMDD (mismo formato que el generador)
+static std::string textoFecha(int32_t fecha) {
+    return std::to_string(fecha % 100) + "/" + std::to_string(fecha / 100 % 100) + "/" + std::to_string(fecha / 10000);
+}
+
+/**
+ * Diccionario de texto en construcción: asigna códigos consecutivos a textos nuevos.
+ * Se serializa como: cantidad (u32), cantidad + 1 desplazamientos (u32) y los caracteres.
+ */
+struct DiccionarioTexto {
+    std::vector<std::string> textos;
+    std::unordered_map<std::string, uint32_t> codigos;
+
+    uint32_t codificar(const std::string& texto) {
+        auto it = codigos.find(texto);
+        if (it != codigos.end()) {
+            return it->second;
+        }
+        uint32_t codigo = static_cast<uint32_t>(textos.size());
+        codigos.emplace(texto, codigo);
+        textos.push_back(texto);
+        return codigo;
+    }
+
+    std::vector<unsigned char> serializar() const {
+        std::vector<uint32_t> desplazamientos;
+        desplazamientos.push_back(0);
+        for (const std::string& texto : textos) {
+            desplazamientos.push_back(desplazamientos.back() + static_cast<uint32_t>(texto.size()));
+        }
+        uint32_t cantidad = static_cast<uint32_t>(textos.size());
+        std::vector<unsigned char> datos(sizeof(uint32_t) * (1 + desplazamientos.size()) + desplazamientos.back());
+        unsigned char* p = datos.data();
+        std::memcpy(p, &cantidad, sizeof(cantidad));
+        p += sizeof(cantidad);
+        std::memcpy(p, desplazamientos.data(), desplazamientos.size() * sizeof(uint32_t));
+        p += desplazamientos.size() * sizeof(uint32_t);
+        for (const std::string& texto : textos) {
+            std::memcpy(p, texto.data(), texto.size());
+            p += texto.size();
+        }
+        return datos;
+    }
+};
+
+// Lee un diccionario serializado; false si está mal formado
+static bool leerDiccionario(const unsigned char* datos, uint64_t bytes, std::vector<std::string>& textos) {
+    textos.clear();
+    uint32_t cantidad;
+    if (bytes < sizeof(cantidad)) {
+        return false;
+    }
+    std::memcpy(&cantidad, datos, sizeof(cantidad));
+    uint64_t cabecera = sizeof(uint32_t) * (2 + static_cast<uint64_t>(cantidad));
+    if (bytes < cabecera) {
+        return false;
+    }
+    std::vector<uint32_t> desplazamientos(cantidad + 1);
+    std::memcpy(desplazamientos.data(), datos + sizeof(uint32_t), desplazamientos.size() * sizeof(uint32_t));
+    const char* caracteres = reinterpret_cast<const char*>(datos + cabecera);
+    for (uint32_t i = 0; i < cantidad; ++i) {
+        if (desplazamientos[i] > desplazamientos[i + 1] || cabecera + desplazamientos[i + 1] > bytes) {
+            return false;
+        }
+        textos.emplace_back(caracteres + desplazamientos[i], desplazamientos[i + 1] - desplazamientos[i]);
+    }
+    return true;
+}
+
+/**
+ * Implementación de guardar.
+ *
+ * POR QUÉ: Volcar el conjunto en el formato que abrir() proyecta tal cual.
+ * CÓMO: 1) diccionarios y códigos de nombre/apellido, 2) cálculo de desplazamientos alineados,
+ *       3) cabecera y secciones escritas en orden con relleno entre ellas.
+ * PARA QUÉ: Persistencia compacta (unos 44 bytes por fila más los diccionarios).
+ */
+bool Instantanea::guardar(const std::string& ruta, const ColeccionPersonas& personas, const TablaPersonas& tabla) {
+    const size_t n = personas.size();
+    if (tabla.tamano() != n) {
+        std::cerr << "Error: la tabla columnar no corresponde a la colección\n";
+        return false;
+    }
+
+    DiccionarioTexto dicNombres, dicApellidos;
+    std::vector<uint64_t> ids(n);
+    std::vector<uint16_t> codNombre(n), codApellido(n);
+    for (size_t i = 0; i < n; ++i) {
+        ids[i] = personas[i].getId();
+        uint32_t nombre = dicNombres.codificar(personas[i].getNombre());
+        uint32_t apellido = dicApellidos.codificar(personas[i].getApellido());
+        if (nombre > UINT16_MAX || apellido > UINT16_MAX) {
+            std::cerr << "Error: demasiados nombres o apellidos distintos para la instantánea\n";
+            return false;
+        }
+        codNombre[i] = static_cast<uint16_t>(nombre);
+        codApellido[i] = static_cast<uint16_t>(apellido);
+    }
+    DiccionarioTexto dicCiudades;
+    for (const std::string& ciudad : tabla.getCiudades()) {
+        dicCiudades.textos.push_back(ciudad); // Mismos códigos que la tabla
+    }
+
+    std::vector<unsigned char> datosNombres = dicNombres.serializar();
+    std::vector<unsigned char> datosApellidos = dicApellidos.serializar();
+    std::vector<unsigned char> datosCiudades = dicCiudades.serializar();
+    const ColumnasPersonas columnas = tabla.columnas();
+
+    // Contenido de cada sección
+    const void* contenido[NUM_SECCIONES] = {
+        datosNombres.data(), datosApellidos.data(), datosCiudades.data(),
+        ids.data(), columnas.ingresos, columnas.patrimonio, tabla.getDeudas().data(), columnas.fechaNacimiento,
+        codNombre.data(), codApellido.data(), columnas.codigoCiudad, columnas.calendario, columnas.declarante
+    };
+    const uint64_t tamanos[NUM_SECCIONES] = {
+        datosNombres.size(), datosApellidos.size(), datosCiudades.size(),
+        n * sizeof(uint64_t), n * sizeof(double), n * sizeof(double), n * sizeof(double), n * sizeof(int32_t),
+        n * sizeof(uint16_t), n * sizeof(uint16_t), n, n, (n + 63) / 64 * sizeof(uint64_t)
+    };
+
+    CabeceraInstantanea cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::memcpy(cabecera.magia, MAGIA, sizeof(MAGIA));
+    cabecera.version = VERSION_INSTANTANEA;
+    cabecera.marcaOrden = MARCA_ORDEN;
+    cabecera.filas = n;
+    uint64_t posicion = alinear(sizeof(cabecera));
+    for (int s = 0; s < NUM_SECCIONES; ++s) {
+        cabecera.secciones[s].desplazamiento = posicion;
+        cabecera.secciones[s].bytes = tamanos[s];
+        posicion = alinear(posicion + tamanos[s]);
+    }
+    cabecera.bytesArchivo = posicion;
+
+    std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+    if (!archivo) {
+        std::cerr << "Error al abrir archivo: " << ruta << std::endl;
+        return false;
+    }
+    static const char relleno[ALINEACION] = {};
+    archivo.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    uint64_t escrito = sizeof(cabecera);
+    for (int s = 0; s < NUM_SECCIONES; ++s) {
+        archivo.write(relleno, cabecera.secciones[s].desplazamiento - escrito);
+        archivo.write(static_cast<const char*>(contenido[s]), tamanos[s]);
+        escrito = cabecera.secciones[s].desplazamiento + tamanos[s];
+    }
+    archivo.write(relleno, cabecera.bytesArchivo - escrito);
+    archivo.close();
+    if (!archivo) {
+        std::cerr << "Error al escribir la instantánea: " << ruta << std::endl;
+        return false;
+    }
+    return true;
+}
+
+Instantanea::~Instantanea() {
+    cerrar();
+}
+
+Instantanea::Instantanea(Instantanea&& otra) noexcept {
+    *this = std::move(otra);
+}
+
+Instantanea& Instantanea::operator=(Instantanea&& otra) noexcept {
+    if (this == &otra) {
+        return *this;
+    }
+    cerrar();
+    base = otra.base;
+    bytes = otra.bytes;
+    filas = otra.filas;
+    columnaId = otra.columnaId;
+    ingresos = otra.ingresos;
+    patrimonio = otra.patrimonio;
+    deudas = otra.deudas;
+    fechaNacimiento = otra.fechaNacimiento;
+    codigoNombre = otra.codigoNombre;
+    codigoApellido = otra.codigoApellido;
+    codigoCiudad = otra.codigoCiudad;
+    calendario = otra.calendario;
+    declarante = otra.declarante;
+    nombres = std::move(otra.nombres);
+    apellidos = std::move(otra.apellidos);
+    ciudades = std::move(otra.ciudades);
+    nombreGlobal = std::move(otra.nombreGlobal);
+    apellidoPaternoGlobal = std::move(otra.apellidoPaternoGlobal);
+    apellidoMaternoGlobal = std::move(otra.apellidoMaternoGlobal);
+    ciudadGlobal = std::move(otra.ciudadGlobal);
+    otra.base = nullptr; // La proyección ya no es suya: cerrar() no debe liberarla
+    otra.cerrar();
+    return *this;
+}
+
+void Instantanea::cerrar() {
+    if (base) {
+        munmap(const_cast<unsigned char*>(base), bytes);
+    }
+    base = nullptr;
+    bytes = 0;
+    filas = 0;
+    nombres.clear();
+    apellidos.clear();
+    ciudades.clear();
+    nombreGlobal.clear();
+    apellidoPaternoGlobal.clear();
+    apellidoMaternoGlobal.clear();
+    ciudadGlobal.clear();
+}
+
+// Traduce los diccionarios del archivo a códigos de Persona; los apellidos compuestos se
+// separan como en el constructor de Persona (primer espacio)
+void Instantanea::traducirDiccionarios() {
+    for (const std::string& nombre : nombres) {
+        nombreGlobal.push_back(diccionarioNombres().codificar(nombre));
+    }
+    for (const std::string& apellido : apellidos) {
+        size_t espacio = apellido.find(' ');
+        apellidoPaternoGlobal.push_back(diccionarioApellidos().codificar(apellido.substr(0, espacio)));
+        apellidoMaternoGlobal.push_back(
+            espacio == std::string::npos ? 0 : diccionarioApellidos().codificar(apellido.substr(espacio + 1)));
+    }
+    for (const std::string& ciudad : ciudades) {
+        ciudadGlobal.push_back(static_cast<uint8_t>(diccionarioCiudades().codificar(ciudad)));
+    }
+}
+
+/**
+ * Implementación de abrir.
+ *
+ * POR QUÉ: Usar el archivo sin leerlo ni convertirlo.
+ * CÓMO: mmap de solo lectura; se validan cabecera, tamaños de sección y que los códigos de
+ *       ciudad y calendario estén dentro de rango (el agregador los usa como índices). Si sus
+ *       textos desbordan los diccionarios del proceso, el archivo se rechaza sin terminar.
+ * PARA QUÉ: Carga en milisegundos; el sistema operativo trae las páginas cuando se leen.
+ */
+bool Instantanea::abrir(const std::string& ruta) {
+    cerrar();
+
+    int fd = open(ruta.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error al abrir archivo: " << ruta << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(CabeceraInstantanea)) {
+        std::cerr << "Error: " << ruta << " no es una instantánea válida\n";
+        close(fd);
+        return false;
+    }
+    bytes = static_cast<size_t>(info.st_size);
+    void* proyeccion = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // La proyección sigue siendo válida sin el descriptor
+    if (proyeccion == MAP_FAILED) {
+        std::cerr << "Error al proyectar en memoria: " << ruta << std::endl;
+        bytes = 0;
+        return false;
+    }
+    base = static_cast<const unsigned char*>(proyeccion);
+
+    CabeceraInstantanea cabecera;
+    std::memcpy(&cabecera, base, sizeof(cabecera));
+    bool valida = std::memcmp(cabecera.magia, MAGIA, sizeof(MAGIA)) == 0 &&
+                  cabecera.version == VERSION_INSTANTANEA && cabecera.marcaOrden == MARCA_ORDEN &&
+                  cabecera.bytesArchivo == bytes;
+
+    const uint64_t n = cabecera.filas;
+    const uint64_t esperados[NUM_SECCIONES] = {
+        0, 0, 0,
+        n * sizeof(uint64_t), n * sizeof(double), n * sizeof(double), n * sizeof(double), n * sizeof(int32_t),
+        n * sizeof(uint16_t), n * sizeof(uint16_t), n, n, (n + 63) / 64 * sizeof(uint64_t)
+    };
+    for (int s = 0; valida && s < NUM_SECCIONES; ++s) {
+        const uint64_t desplazamiento = cabecera.secciones[s].desplazamiento;
+        const uint64_t tamano = cabecera.secciones[s].bytes;
+        valida = desplazamiento % ALINEACION == 0 && desplazamiento <= bytes && tamano <= bytes - desplazamiento &&
+                 (s <= DICC_CIUDADES || tamano == esperados[s]);
+    }
+    auto seccion = [&](int s) { return base + cabecera.secciones[s].desplazamiento; };
+    valida = valida &&
+             leerDiccionario(seccion(DICC_NOMBRES), cabecera.secciones[DICC_NOMBRES].bytes, nombres) &&
+             leerDiccionario(seccion(DICC_APELLIDOS), cabecera.secciones[DICC_APELLIDOS].bytes, apellidos) &&
+             leerDiccionario(seccion(DICC_CIUDADES), cabecera.secciones[DICC_CIUDADES].bytes, ciudades) &&
+             ciudades.size() <= static_cast<size_t>(UINT8_MAX) + 1;
+    if (!valida) {
+        std::cerr << "Error: " << ruta << " no es una instantánea válida\n";
+        cerrar();
+        return false;
+    }
+
+    filas = n;
+    columnaId = reinterpret_cast<const uint64_t*>(seccion(COL_ID));
+    ingresos = reinterpret_cast<const double*>(seccion(COL_INGRESOS));
+    patrimonio = reinterpret_cast<const double*>(seccion(COL_PATRIMONIO));
+    deudas = reinterpret_cast<const double*>(seccion(COL_DEUDAS));
+    fechaNacimiento = reinterpret_cast<const int32_t*>(seccion(COL_FECHA));
+    codigoNombre = reinterpret_cast<const uint16_t*>(seccion(COL_NOMBRE));
+    codigoApellido = reinterpret_cast<const uint16_t*>(seccion(COL_APELLIDO));
+    codigoCiudad = seccion(COL_CIUDAD);
+    calendario = seccion(COL_CALENDARIO);
+    declarante = reinterpret_cast<const uint64_t*>(seccion(COL_DECLARANTE));
+
+    // Códigos usados como índices por el agregador: se comprueban una vez aquí
+    uint8_t maxCiudad = 0, maxCalendario = 0;
+    for (size_t i = 0; i < filas; ++i) {
+        maxCiudad = std::max(maxCiudad, codigoCiudad[i]);
+        maxCalendario = std::max(maxCalendario, calendario[i]);
+    }
+    if (filas > 0 && (maxCiudad >= ciudades.size() || maxCalendario > 2)) {
+        std::cerr << "Error: " << ruta << " contiene códigos fuera de rango\n";
+        cerrar();
+        return false;
+    }
+    try {
+        traducirDiccionarios();
+    } catch (const std::length_error& e) {
+        // Los textos del archivo no caben en los diccionarios del proceso
+        std::cerr << "Error: " << ruta << ": " << e.what() << "\n";
+        cerrar();
+        return false;
+    }
+    return true;
+}
+
+ColumnasPersonas Instantanea::columnas() const {
+    return ColumnasPersonas{filas, ingresos, patrimonio, fechaNacimiento, codigoCiudad, calendario, declarante};
+}
+
+// Reconstruye la persona de una fila; los códigos fuera de diccionario dan texto vacío (código 0)
+Persona Instantanea::persona(size_t fila) const {
+    uint16_t nombre = codigoNombre[fila] < nombreGlobal.size() ? nombreGlobal[codigoNombre[fila]] : 0;
+    uint16_t paterno = 0, materno = 0;
+    if (codigoApellido[fila] < apellidoPaternoGlobal.size()) {
+        paterno = apellidoPaternoGlobal[codigoApellido[fila]];
+        materno = apellidoMaternoGlobal[codigoApellido[fila]];
+    }
+    bool esDeclarante = (declarante[fila >> 6] >> (fila & 63)) & 1u;
+    return Persona(nombre, paterno, materno, columnaId[fila], ciudadGlobal[codigoCiudad[fila]],
+                   textoFecha(fechaNacimiento[fila]), ingresos[fila], patrimonio[fila], deudas[fila], esDeclarante);
+}
+
+/**
+ * Implementación de materializar.
+ *
+ * POR QUÉ: Pasar de la proyección a las estructuras de la sesión sin un recorrido secuencial.
+ * CÓMO: Tramos de TAM_TRAMO_MATERIALIZAR filas repartidos con un contador atómico; la tabla se
+ *       prepara con el diccionario de ciudades del archivo, así conserva los mismos códigos.
+ * PARA QUÉ: Opciones clásicas del menú sobre datos cargados.
+ */
+void Instantanea::materializar(ColeccionPersonas& personas, TablaPersonas& tabla, PoolHilos& pool) const {
+    static const size_t TAM_TRAMO_MATERIALIZAR = 4096; // Múltiplo de 64 (bitset de la tabla)
+
+    personas.assign(filas, Persona());
+    tabla.preparar(filas, ciudades);
+
+    const size_t numTramos = (filas + TAM_TRAMO_MATERIALIZAR - 1) / TAM_TRAMO_MATERIALIZAR;
+    std::atomic<size_t> siguienteTramo(0);
+    pool.ejecutar([&](size_t) {
+        for (size_t tramo = siguienteTramo++; tramo < numTramos; tramo = siguienteTramo++) {
+            size_t inicio = tramo * TAM_TRAMO_MATERIALIZAR;
+            size_t fin = std::min(filas, inicio + TAM_TRAMO_MATERIALIZAR);
+            for (size_t i = inicio; i < fin; ++i) {
+                personas[i] = persona(i);
+                tabla.asignar(i, personas[i], codigoCiudad[i]);
+            }
+        }
+    });
+}
+
+// --- EscritorInstantanea ---
+
+/**
+ * Diccionarios del archivo en construcción.
+ * Traducen códigos de Persona a códigos del archivo con un acceso a tabla por fila: el texto
+ * solo se consulta la primera vez que aparece un nombre o un par de apellidos.
+ */
+struct EscritorInstantanea::Diccionarios {
+    DiccionarioTexto nombres, apellidos;
+    std::vector<int32_t> nombreArchivo;                  // Código de Persona -> código del archivo (-1 = nuevo)
+    std::unordered_map<uint32_t, uint32_t> apellidoArchivo; // (paterno << 16 | materno) -> código del archivo
+    std::vector<uint64_t> ids;
+    std::vector<uint16_t> codNombre, codApellido;
+};
+
+EscritorInstantanea::EscritorInstantanea() = default;
+
+EscritorInstantanea::~EscritorInstantanea() {
+    abortar();
+}
+
+void EscritorInstantanea::abortar() {
+    if (fd >= 0) {
+        close(fd);
+    }
+    fd = -1;
+    diccionarios.reset();
+}
+
+bool EscritorInstantanea::escribirEn(uint64_t desplazamiento, const void* datos, size_t bytes) {
+    const char* p = static_cast<const char*>(datos);
+    while (bytes > 0) {
+        ssize_t escritos = pwrite(fd, p, bytes, static_cast<off_t>(desplazamiento));
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error al escribir la instantánea: " << ruta << std::endl;
+            abortar();
+            return false;
+        }
+        p += escritos;
+        bytes -= static_cast<size_t>(escritos);
+        desplazamiento += static_cast<uint64_t>(escritos);
+    }
+    return true;
+}
+
+bool EscritorInstantanea::abrir(const std::string& archivo, uint64_t n, const std::vector<std::string>& nombresCiudad) {
+    abortar();
+    if (nombresCiudad.size() > static_cast<size_t>(UINT8_MAX) + 1) {
+        std::cerr << "Error: demasiadas ciudades distintas para la instantánea\n";
+        return false;
+    }
+    fd = open(archivo.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error al abrir archivo: " << archivo << std::endl;
+        return false;
+    }
+    ruta = archivo;
+    filas = n;
+    escritas = 0;
+    ciudades = nombresCiudad;
+    diccionarios = std::make_unique<Diccionarios>();
+
+    // Columnas primero, en el orden de las secciones; los diccionarios irán detrás
+    const uint64_t tamanos[NUM_SECCIONES] = {
+        0, 0, 0,
+        n * sizeof(uint64_t), n * sizeof(double), n * sizeof(double), n * sizeof(double), n * sizeof(int32_t),
+        n * sizeof(uint16_t), n * sizeof(uint16_t), n, n, (n + 63) / 64 * sizeof(uint64_t)
+    };
+    desplazamientos.assign(NUM_SECCIONES, 0);
+    uint64_t posicion = alinear(sizeof(CabeceraInstantanea));
+    for (int s = COL_ID; s < NUM_SECCIONES; ++s) {
+        desplazamientos[s] = posicion;
+        posicion = alinear(posicion + tamanos[s]);
+    }
+    finColumnas = posicion;
+    return true;
+}
+
+/**
+ * Implementación de escribir.
+ *
+ * POR QUÉ: Cada lote ocupa un tramo conocido de cada columna.
+ * CÓMO: Traduce IDs y códigos de nombre/apellido del lote a arreglos propios (reutilizados) y
+ *       escribe cada columna en desplazamiento + primeraFila * ancho; el bitset del lote empieza
+ *       en una palabra propia porque primeraFila es múltiplo de 64.
+ * PARA QUÉ: Escritura secuencial por columna sin guardar el conjunto.
+ */
+bool EscritorInstantanea::escribir(uint64_t primeraFila, const ColeccionPersonas& personas, const TablaPersonas& tabla) {
+    TramoPerfil tramo("escribir lote");
+    if (fd < 0) {
+        return false;
+    }
+    const size_t n = personas.size();
+    if (tabla.tamano() != n || primeraFila != escritas || primeraFila % 64 != 0 || primeraFila + n > filas ||
+        tabla.getCiudades() != ciudades) {
+        std::cerr << "Error: el lote no corresponde a la instantánea (fila " << primeraFila << ")\n";
+        abortar();
+        return false;
+    }
+
+    Diccionarios& d = *diccionarios;
+    d.ids.resize(n);
+    d.codNombre.resize(n);
+    d.codApellido.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const Persona& persona = personas[i];
+        d.ids[i] = persona.getId();
+
+        const uint16_t nombre = persona.getCodigoNombre();
+        if (nombre >= d.nombreArchivo.size()) {
+            d.nombreArchivo.resize(nombre + 1, -1);
+        }
+        if (d.nombreArchivo[nombre] < 0) {
+            d.nombreArchivo[nombre] = static_cast<int32_t>(d.nombres.codificar(persona.getNombre()));
+        }
+
+        const uint32_t clave = static_cast<uint32_t>(persona.getCodigoApellidoPaterno()) << 16 |
+                               persona.getCodigoApellidoMaterno();
+        auto it = d.apellidoArchivo.find(clave);
+        if (it == d.apellidoArchivo.end()) {
+            it = d.apellidoArchivo.emplace(clave, d.apellidos.codificar(persona.getApellido())).first;
+        }
+        if (d.nombreArchivo[nombre] > UINT16_MAX || it->second > UINT16_MAX) {
+            std::cerr << "Error: demasiados nombres o apellidos distintos para la instantánea\n";
+            abortar();
+            return false;
+        }
+        d.codNombre[i] = static_cast<uint16_t>(d.nombreArchivo[nombre]);
+        d.codApellido[i] = static_cast<uint16_t>(it->second);
+    }
+
+    const ColumnasPersonas columnas = tabla.columnas();
+    const void* contenido[NUM_SECCIONES] = {
+        nullptr, nullptr, nullptr,
+        d.ids.data(), columnas.ingresos, columnas.patrimonio, tabla.getDeudas().data(), columnas.fechaNacimiento,
+        d.codNombre.data(), d.codApellido.data(), columnas.codigoCiudad, columnas.calendario, columnas.declarante
+    };
+    const size_t anchos[NUM_SECCIONES] = {
+        0, 0, 0,
+        sizeof(uint64_t), sizeof(double), sizeof(double), sizeof(double), sizeof(int32_t),
+        sizeof(uint16_t), sizeof(uint16_t), 1, 1, 0
+    };
+    for (int s = COL_ID; s < COL_DECLARANTE; ++s) {
+        if (!escribirEn(desplazamientos[s] + primeraFila * anchos[s], contenido[s], n * anchos[s])) {
+            return false;
+        }
+    }
+    if (!escribirEn(desplazamientos[COL_DECLARANTE] + primeraFila / 64 * sizeof(uint64_t),
+                    contenido[COL_DECLARANTE], (n + 63) / 64 * sizeof(uint64_t))) {
+        return false;
+    }
+    escritas += n;
+    return true;
+}
+
+/**
+ * Implementación de terminar.
+ *
+ * POR QUÉ: Los diccionarios solo se conocen cuando llegó el último lote.
+ * CÓMO: Los serializa detrás de las columnas, escribe la cabecera con todos los
+ *       desplazamientos y ajusta el tamaño del archivo (el relleno final queda en ceros).
+ * PARA QUÉ: Un archivo que Instantanea::abrir() acepta igual que uno de guardar().
+ */
+bool EscritorInstantanea::terminar() {
+    if (fd < 0) {
+        return false;
+    }
+    if (escritas != filas) {
+        std::cerr << "Error: la instantánea " << ruta << " quedó incompleta (" << escritas << " de " << filas
+                  << " filas)\n";
+        abortar();
+        return false;
+    }
+    DiccionarioTexto dicCiudades;
+    dicCiudades.textos = ciudades; // Mismos códigos que las tablas de los lotes
+    const std::vector<unsigned char> datos[3] = {
+        diccionarios->nombres.serializar(), diccionarios->apellidos.serializar(), dicCiudades.serializar()
+    };
+
+    CabeceraInstantanea cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::memcpy(cabecera.magia, MAGIA, sizeof(MAGIA));
+    cabecera.version = VERSION_INSTANTANEA;
+    cabecera.marcaOrden = MARCA_ORDEN;
+    cabecera.filas = filas;
+    const uint64_t n = filas;
+    const uint64_t tamanos[NUM_SECCIONES] = {
+        datos[0].size(), datos[1].size(), datos[2].size(),
+        n * sizeof(uint64_t), n * sizeof(double), n * sizeof(double), n * sizeof(double), n * sizeof(int32_t),
+        n * sizeof(uint16_t), n * sizeof(uint16_t), n, n, (n + 63) / 64 * sizeof(uint64_t)
+    };
+    uint64_t posicion = finColumnas;
+    for (int s = DICC_NOMBRES; s <= DICC_CIUDADES; ++s) {
+        desplazamientos[s] = posicion;
+        if (!escribirEn(posicion, datos[s].data(), datos[s].size())) {
+            return false;
+        }
+        posicion = alinear(posicion + datos[s].size());
+    }
+    for (int s = 0; s < NUM_SECCIONES; ++s) {
+        cabecera.secciones[s].desplazamiento = desplazamientos[s];
+        cabecera.secciones[s].bytes = tamanos[s];
+    }
+    cabecera.bytesArchivo = posicion;
+    if (!escribirEn(0, &cabecera, sizeof(cabecera))) {
+        return false;
+    }
+    bool correcto = ftruncate(fd, static_cast<off_t>(posicion)) == 0;
+    correcto = close(fd) == 0 && correcto;
+    fd = -1;
+    diccionarios.reset();
+    if (!correcto) {
+        std::cerr << "Error al escribir la instantánea: " << ruta << std::endl;
+    }
+    return correcto;
+}
@@ -0,0 +1,150 @@
+#ifndef INSTANTANEA_H
+#define INSTANTANEA_H
+
+#include "persona.h"
+#include "tabla.h"
+#include "hilos.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Instantánea binaria columnar de un conjunto de datos, abierta con mmap.
+ *
+ * POR QUÉ: Cada sesión regeneraba los datos desde cero; no había forma de guardarlos.
+ * CÓMO: Un archivo con cabecera, diccionarios de texto (nombres, apellidos, ciudades) y
+ *       columnas de ancho fijo alineadas a 64 bytes (ID, ingresos, patrimonio, deudas, fecha
+ *       AAAAMMDD, códigos de diccionario, calendario y bitset de declarantes). Al abrirlo solo
+ *       se proyecta en memoria y se validan cabecera y códigos; las columnas se leen en el sitio.
+ * PARA QUÉ: Reiniciar el análisis sobre decenas de millones de filas en milisegundos y
+ *           consultarlas con el agregador sin deserializar.
+ */
+class Instantanea {
+public:
+    Instantanea() = default;
+    ~Instantanea();
+
+    Instantanea(const Instantanea&) = delete;
+    Instantanea& operator=(const Instantanea&) = delete;
+
+    // Mover traspasa la proyección: así se abre en una temporal y solo se adopta si es válida
+    Instantanea(Instantanea&& otra) noexcept;
+    Instantanea& operator=(Instantanea&& otra) noexcept;
+
+    /**
+     * Escribe un conjunto de datos en un archivo de instantánea.
+     *
+     * POR QUÉ: Persistir lo generado en la opción 0.
+     * CÓMO: Construye los diccionarios de nombres y apellidos y copia las columnas de la tabla.
+     * PARA QUÉ: Cargarlo después con abrir().
+     * @param tabla Tabla columnar alineada con 'personas'.
+     * @return true si el archivo se escribió completo.
+     */
+    static bool guardar(const std::string& ruta, const ColeccionPersonas& personas, const TablaPersonas& tabla);
+
+    /**
+     * Proyecta en memoria un archivo de instantánea (cierra el anterior).
+     * @return true si el archivo es válido; en caso contrario informa el error y queda cerrada.
+     */
+    bool abrir(const std::string& ruta);
+
+    void cerrar();
+    bool abierta() const { return base != nullptr; }
+    size_t tamano() const { return filas; }
+
+    // Columnas analíticas leídas directamente del archivo (válidas mientras esté abierta)
+    ColumnasPersonas columnas() const;
+    const uint64_t* ids() const { return columnaId; }
+
+    // Diccionarios (pequeños; se copian al abrir)
+    const std::vector<std::string>& getCiudades() const { return ciudades; }
+
+    // Reconstruye la persona de una fila
+    Persona persona(size_t fila) const;
+
+    /**
+     * Reconstruye todo el conjunto como vector de Persona y tabla columnar.
+     *
+     * POR QUÉ: Las opciones del menú basadas en Persona necesitan el vector.
+     * CÓMO: En paralelo por tramos alineados a 64 filas, igual que la generación.
+     * PARA QUÉ: Usar las opciones clásicas sobre datos cargados de disco.
+     */
+    void materializar(ColeccionPersonas& personas, TablaPersonas& tabla, PoolHilos& pool) const;
+
+private:
+    const unsigned char* base = nullptr; // Inicio de la proyección
+    size_t bytes = 0;                    // Tamaño de la proyección
+    size_t filas = 0;
+
+    const uint64_t* columnaId = nullptr;
+    const double* ingresos = nullptr;
+    const double* patrimonio = nullptr;
+    const double* deudas = nullptr;
+    const int32_t* fechaNacimiento = nullptr;
+    const uint16_t* codigoNombre = nullptr;
+    const uint16_t* codigoApellido = nullptr;
+    const uint8_t* codigoCiudad = nullptr;
+    const uint8_t* calendario = nullptr;
+    const uint64_t* declarante = nullptr;
+
+    std::vector<std::string> nombres;
+    std::vector<std::string> apellidos;
+    std::vector<std::string> ciudades;
+
+    // Código del archivo -> código de los diccionarios de Persona (se traduce una vez al abrir)
+    std::vector<uint16_t> nombreGlobal;
+    std::vector<uint16_t> apellidoPaternoGlobal;
+    std::vector<uint16_t> apellidoMaternoGlobal;
+    std::vector<uint8_t> ciudadGlobal;
+    void traducirDiccionarios();
+};
+
+/**
+ * Escritor de instantáneas por lotes (mismo formato que Instantanea::guardar).
+ *
+ * POR QUÉ: guardar() necesita la colección y la tabla completas en memoria.
+ * CÓMO: Conociendo de antemano el número de filas, cada columna tiene un desplazamiento fijo y
+ *       cada lote se escribe en su sitio con pwrite. Los diccionarios se construyen mientras
+ *       llegan los lotes y se escriben al final, después de las columnas (la cabecera guarda
+ *       el desplazamiento de cada sección, así que abrir() no depende del orden).
+ * PARA QUÉ: Guardar conjuntos generados con generarPorLotes sin materializarlos.
+ */
+class EscritorInstantanea {
+public:
+    EscritorInstantanea(); // En el .cpp: Diccionarios solo está completo allí
+    ~EscritorInstantanea();
+
+    EscritorInstantanea(const EscritorInstantanea&) = delete;
+    EscritorInstantanea& operator=(const EscritorInstantanea&) = delete;
+
+    // Crea el archivo para 'filas' filas con las ciudades de 'ciudades' (en orden de código)
+    bool abrir(const std::string& ruta, uint64_t filas, const std::vector<std::string>& ciudades);
+
+    /**
+     * Escribe un lote de filas consecutivas a partir de primeraFila (múltiplo de 64).
+     * @param tabla Tabla columnar del lote, alineada con 'personas' y con las ciudades de abrir().
+     * @return false si hubo un error (el escritor queda cerrado y el archivo incompleto).
+     */
+    bool escribir(uint64_t primeraFila, const ColeccionPersonas& personas, const TablaPersonas& tabla);
+
+    // Escribe diccionarios y cabecera; false si no se escribieron todas las filas anunciadas
+    bool terminar();
+
+private:
+    bool escribirEn(uint64_t desplazamiento, const void* datos, size_t bytes);
+    void abortar();
+
+    int fd = -1;
+    std::string ruta;
+    uint64_t filas = 0;
+    uint64_t escritas = 0;
+    uint64_t finColumnas = 0;
+    std::vector<uint64_t> desplazamientos; // Uno por sección
+    std::vector<std::string> ciudades;
+    // Diccionarios en construcción y códigos del lote actual (se reutilizan entre lotes)
+    struct Diccionarios;
+    std::unique_ptr<Diccionarios> diccionarios;
+};
+
+#endif // INSTANTANEA_H
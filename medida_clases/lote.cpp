@@ -0,0 +1,254 @@
+#include "lote.h"
+#include <chrono>   // std::chrono::steady_clock
+#include <fstream>  // std::ifstream
+#include <iostream>
+#include <sstream>  // std::istringstream, std::ostringstream
+#include <vector>
+
+// Opciones ficticias para "exportar" y "traza": necesitan el nombre del archivo, que la
+// opción 5 no pide
+static const int OPCION_EXPORTAR = -1;
+static const int OPCION_TRAZA = -2;
+
+/**
+ * Traducción de un comando del guion a una opción del menú.
+ * 'entrada' construye, a partir de los argumentos, el texto que la opción leerá de std::cin.
+ */
+struct DefinicionComando {
+    const char* nombre;
+    const char* alias; // Nombre alternativo en inglés
+    int opcion;
+    size_t minArgs;
+    size_t maxArgs;
+    const char* uso;
+    std::string (*entrada)(const std::vector<std::string>& args);
+};
+
+// Primer argumento o un valor por defecto
+static std::string argumento(const std::vector<std::string>& args, size_t i, const char* porDefecto) {
+    return i < args.size() ? args[i] : porDefecto;
+}
+
+static std::string sinEntrada(const std::vector<std::string>&) {
+    return "";
+}
+
+static std::string unArgumento(const std::vector<std::string>& args) {
+    return args[0] + "\n";
+}
+
+// Submenú de patrimonio: pais = 1, ciudad = 2, grupo = 3 (vacío si no es ninguno)
+static std::string submenuPatrimonio(const std::vector<std::string>& args) {
+    const std::string ambito = argumento(args, 0, "pais");
+    if (ambito == "pais" || ambito == "country") return "1\n";
+    if (ambito == "ciudad" || ambito == "city") return "2\n";
+    if (ambito == "grupo" || ambito == "group") return "3\n";
+    return "";
+}
+
+static const DefinicionComando* buscarComando(const std::string& nombre);
+
+/**
+ * Respuestas de la opción 21: opción, calentamiento, repeticiones y, en una sola línea, las
+ * respuestas del comando repetido (vacío si el comando no existe o sus argumentos no encajan).
+ */
+static std::string repeticion(const std::vector<std::string>& args) {
+    const DefinicionComando* repetido = buscarComando(args[2]);
+    const std::vector<std::string> argsRepetido(args.begin() + 3, args.end());
+    if (!repetido || repetido->opcion < 0 || argsRepetido.size() < repetido->minArgs ||
+        argsRepetido.size() > repetido->maxArgs) {
+        return "";
+    }
+    std::string respuestas = repetido->entrada(argsRepetido);
+    for (char& c : respuestas) {
+        if (c == '\n') {
+            c = ' ';
+        }
+    }
+    return std::to_string(repetido->opcion) + "\n" + args[0] + "\n" + args[1] + "\n" + respuestas + "\n";
+}
+
+// Respuestas de la opción 22: N, semilla, lote y destino (analisis, listado ARCHIVO o guardar ARCHIVO)
+static std::string porLotes(const std::vector<std::string>& args) {
+    const std::string inicio = args[0] + "\n" + args[1] + "\n" + args[2] + "\n";
+    const std::string destino = argumento(args, 3, "analisis");
+    if ((destino == "analisis" || destino == "analyze") && args.size() <= 4) return inicio + "1\n";
+    if ((destino == "listado" || destino == "list") && args.size() == 5) return inicio + "2\n" + args[4] + "\n";
+    if ((destino == "guardar" || destino == "save") && args.size() == 5) return inicio + "3\n" + args[4] + "\n";
+    return inicio + "0\n";
+}
+
+// Respuestas de la opción 23: N, semilla y acción (analisis [TAM_LOTE], fila I o id ID)
+static std::string conjuntoVirtual(const std::vector<std::string>& args) {
+    const std::string inicio = args[0] + "\n" + args[1] + "\n";
+    const std::string accion = argumento(args, 2, "analisis");
+    if (accion == "analisis" || accion == "analyze") return inicio + "1\n" + argumento(args, 3, "1048576") + "\n";
+    if ((accion == "fila" || accion == "row") && args.size() == 4) return inicio + "2\n" + args[3] + "\n";
+    if (accion == "id" && args.size() == 4) return inicio + "3\n" + args[3] + "\n";
+    return inicio + "0\n";
+}
+
+static const DefinicionComando COMANDOS[] = {
+    {"generar", "generate", 0, 1, 2, "generar N [semilla=1]",
+     [](const std::vector<std::string>& a) { return a[0] + "\n" + argumento(a, 1, "1") + "\n"; }},
+    {"listar", "list", 1, 0, 1, "listar [N primeras filas]",
+     [](const std::vector<std::string>& a) { return a.empty() ? std::string("1\n") : "3\n" + a[0] + "\n"; }},
+    {"detalle", "show", 2, 1, 1, "detalle INDICE", unArgumento},
+    {"buscar", "find", 3, 1, 1, "buscar ID", unArgumento},
+    {"resumen", "stats", 4, 0, 0, "resumen", sinEntrada},
+    {"exportar", "export", OPCION_EXPORTAR, 0, 1, "exportar [archivo.csv]", sinEntrada},
+    {"traza", "trace", OPCION_TRAZA, 0, 1, "traza [archivo.json]", sinEntrada},
+    {"longevo-valor", "oldest-value", 6, 0, 0, "longevo-valor", sinEntrada},
+    {"longevo", "oldest", 7, 0, 0, "longevo", sinEntrada},
+    {"declarantes-valor", "declarants-value", 8, 0, 0, "declarantes-valor", sinEntrada},
+    {"declarantes", "declarants", 9, 0, 0, "declarantes", sinEntrada},
+    {"ranking-grupo-valor", "rank-group-value", 10, 0, 0, "ranking-grupo-valor", sinEntrada},
+    {"ranking-grupo", "rank-group", 11, 0, 0, "ranking-grupo", sinEntrada},
+    {"ranking-ciudad-valor", "rank-city-value", 12, 0, 0, "ranking-ciudad-valor", sinEntrada},
+    {"ranking-ciudad", "rank-city", 13, 0, 0, "ranking-ciudad", sinEntrada},
+    {"patrimonio-valor", "patrimonio-value", 14, 0, 1, "patrimonio-valor [pais|ciudad|grupo]", submenuPatrimonio},
+    {"patrimonio", "wealth", 15, 0, 1, "patrimonio [pais|ciudad|grupo]", submenuPatrimonio},
+    {"analisis", "analyze", 17, 0, 0, "analisis", sinEntrada},
+    {"paralelo", "parallel", 18, 0, 1, "paralelo [hilos máximos=todos]",
+     [](const std::vector<std::string>& a) { return argumento(a, 0, "0") + "\n"; }},
+    {"guardar", "save", 19, 1, 1, "guardar archivo", unArgumento},
+    {"cargar", "load", 20, 1, 1, "cargar archivo", unArgumento},
+    {"repetir", "repeat", 21, 3, 8, "repetir CALENTAMIENTO N comando [args...]", repeticion},
+    {"lotes", "stream", 22, 3, 5, "lotes N SEMILLA TAM_LOTE [analisis | listado ARCHIVO | guardar ARCHIVO]", porLotes},
+    {"virtual", "virtual", 23, 2, 4, "virtual N SEMILLA [analisis [TAM_LOTE] | fila I | id ID]", conjuntoVirtual},
+};
+
+static const DefinicionComando* buscarComando(const std::string& nombre) {
+    for (const DefinicionComando& comando : COMANDOS) {
+        if (nombre == comando.nombre || nombre == comando.alias) {
+            return &comando;
+        }
+    }
+    return nullptr;
+}
+
+bool leerGuion(int argc, char* argv[], std::string& guion) {
+    std::string primero = argv[1];
+    if (primero == "-f" || primero == "-c") {
+        if (argc != 3) {
+            std::cerr << "Uso: " << argv[0] << " [--asignaciones] [--contadores] [--muestreo MS] [--siempre N] -f guion.txt | -c \"comando; comando...\" | comando args \\; ...\n";
+            return false;
+        }
+        if (primero == "-c") {
+            guion = argv[2];
+            return true;
+        }
+        std::ifstream archivo(argv[2]);
+        if (!archivo) {
+            std::cerr << "Error al abrir archivo: " << argv[2] << std::endl;
+            return false;
+        }
+        std::ostringstream contenido;
+        contenido << archivo.rdbuf();
+        guion = contenido.str();
+        return true;
+    }
+    guion.clear();
+    for (int i = 1; i < argc; ++i) {
+        guion += argv[i];
+        guion += ' ';
+    }
+    return true;
+}
+
+// Separa el guion en comandos: ';' y '\n' terminan un comando, '#' comenta hasta fin de línea
+static std::vector<std::string> separarComandos(const std::string& guion) {
+    std::vector<std::string> comandos;
+    std::string actual;
+    bool comentario = false;
+    for (char c : guion) {
+        if (c == '\n') {
+            comentario = false;
+            comandos.push_back(actual);
+            actual.clear();
+        } else if (comentario) {
+            continue;
+        } else if (c == '#') {
+            comentario = true;
+        } else if (c == ';') {
+            comandos.push_back(actual);
+            actual.clear();
+        } else {
+            actual += c;
+        }
+    }
+    comandos.push_back(actual);
+    return comandos;
+}
+
+/**
+ * Implementación de ejecutarLote.
+ *
+ * POR QUÉ: Reutilizar las opciones del menú sin duplicar su lógica.
+ * CÓMO: Por comando: validar nombre y argumentos, redirigir std::cin a sus respuestas,
+ *       ejecutar la opción, restaurar std::cin y comprobar que no faltaron datos.
+ * PARA QUÉ: Guiones reproducibles con un registro del Monitor por comando.
+ */
+int ejecutarLote(const std::string& guion, Monitor& monitor, const std::function<void(int opcion)>& ejecutar) {
+    for (const std::string& linea : separarComandos(guion)) {
+        std::istringstream partes(linea);
+        std::vector<std::string> palabras;
+        for (std::string palabra; partes >> palabra;) {
+            palabras.push_back(palabra);
+        }
+        if (palabras.empty()) {
+            continue;
+        }
+        const std::string nombre = palabras[0];
+        const std::vector<std::string> args(palabras.begin() + 1, palabras.end());
+
+        const DefinicionComando* comando = buscarComando(nombre);
+        if (!comando) {
+            std::cerr << "Error: comando desconocido '" << nombre << "'\n";
+            return 1;
+        }
+        if (args.size() < comando->minArgs || args.size() > comando->maxArgs) {
+            std::cerr << "Error: uso: " << comando->uso << "\n";
+            return 1;
+        }
+
+        std::cout << "\n>>> " << nombre;
+        for (const std::string& arg : args) {
+            std::cout << " " << arg;
+        }
+        std::cout << "\n";
+
+        if (comando->opcion == OPCION_EXPORTAR) {
+            monitor.exportar_csv(argumento(args, 0, "estadisticas.csv"));
+            continue;
+        }
+        if (comando->opcion == OPCION_TRAZA) {
+            monitor.exportar_traza(argumento(args, 0, "traza.json"));
+            continue;
+        }
+
+        // Respuestas de la opción en lugar del teclado
+        std::istringstream entrada(comando->entrada(args));
+        std::streambuf* teclado = std::cin.rdbuf(entrada.rdbuf());
+        std::cin.clear();
+
+        size_t registrosAntes = monitor.num_registros();
+        long memoriaAntes = monitor.obtener_memoria();
+        auto inicio = std::chrono::steady_clock::now();
+        ejecutar(comando->opcion);
+        std::chrono::duration<double, std::milli> duracion = std::chrono::steady_clock::now() - inicio;
+        bool faltaronDatos = std::cin.fail();
+
+        std::cin.rdbuf(teclado);
+        std::cin.clear();
+
+        if (monitor.num_registros() == registrosAntes) {
+            monitor.registrar(comando->nombre, duracion.count(), monitor.obtener_memoria() - memoriaAntes);
+        }
+        if (faltaronDatos) {
+            std::cerr << "Error: argumentos inválidos para '" << nombre << "' (uso: " << comando->uso << ")\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+#include "monitor.h"
+#include <functional>
+#include <string>
+
+/**
+ * Obtiene el guion del modo lote a partir de los argumentos del programa.
+ *
+ * POR QUÉ: El programa solo se podía usar escribiendo opciones en el menú.
+ * CÓMO: "-f archivo" lee el guion de un archivo; "-c texto" lo toma tal cual; cualquier otra
+ *       cosa se une con espacios (p. ej. programa generar 1000 \; ranking-ciudad).
+ * PARA QUÉ: Ejecutar análisis desde cron o scripts de medición.
+ * @return false (tras informar el error) si el archivo no se puede leer.
+ */
+bool leerGuion(int argc, char* argv[], std::string& guion);
+
+/**
+ * Ejecuta un guion de comandos, uno tras otro.
+ *
+ * POR QUÉ: Medir operaciones de forma repetible sin intervención humana.
+ * CÓMO: Los comandos se separan con ';' o saltos de línea ('#' inicia un comentario). Cada uno
+ *       se traduce a una opción del menú más las respuestas que esa opción lee de std::cin
+ *       (incluidos submenús como el de patrimonio); std::cin se redirige a esas respuestas
+ *       mientras se ejecuta. Si la opción no registra nada en el Monitor, se registra aquí
+ *       con el nombre del comando, de modo que cada comando deja un registro.
+ * PARA QUÉ: Ejecuciones desatendidas con el mismo código que el menú interactivo.
+ *
+ * @param ejecutar Ejecuta una opción del menú sobre la sesión.
+ * @return 0 si todos los comandos se ejecutaron; 1 ante un comando desconocido o argumentos
+ *         inválidos (se detiene en el primero).
+ */
+int ejecutarLote(const std::string& guion, Monitor& monitor, const std::function<void(int opcion)>& ejecutar);
+
+#endif // LOTE_H
@@ -5,7 +5,25 @@
 #include "persona.h"
 #include "generador.h"
 #include "monitor.h"
+#include "tabla.h"
+#include "indice.h"
+#include "agregador.h"
+#include "instantanea.h"
+#include "renderizador.h"
+#include "lote.h"
+#include "asignaciones.h"
+#include "arena.h"
+#include "virtual.h"
 #include <map>
+#include <algorithm> // std::min
+#include <functional> // std::function
+#include <memory_resource> // std::pmr::vector
+#include <cstdlib>    // std::atoi
+#include <cstring>    // std::strerror
+#include <sstream>    // std::istringstream
+#include <string>     // std::getline
+#include <fcntl.h>    // open
+#include <unistd.h>   // close
 /**
  * Muestra el menú principal de la aplicación.
  * 
@@ -20,7 +38,7 @@ void mostrarMenu() {
     std::cout << "\n2. Mostrar detalle completo por índice";
     std::cout << "\n3. Buscar persona por ID";
     std::cout << "\n4. Mostrar estadísticas de rendimiento";
-    std::cout << "\n5. Exportar estadísticas a CSV";
+    std::cout << "\n5. Exportar estadísticas a CSV y traza JSON";
     std::cout << "\n6. Mostrar edad más longeva por país -> [Valor]";
     std::cout << "\n7. Mostrar edad más longeva por país -> [Referencia]";
     std::cout << "\n8. Declarantes de renta -> [Valor]";
@@ -32,305 +50,1027 @@ void mostrarMenu() {
     std::cout << "\n14. Mayor patrimonio -> [Valor]";
     std::cout << "\n15. Mayor patrimonio -> [Referencia]";
     std::cout << "\n16. Salir";
+    std::cout << "\n17. Análisis completo -> [Una pasada]";
+    std::cout << "\n18. Análisis completo -> [Paralelo, barrido de hilos]";
+    std::cout << "\n19. Guardar instantánea binaria";
+    std::cout << "\n20. Cargar instantánea binaria";
+    std::cout << "\n21. Repetir una opción (calentamiento + repeticiones)";
+    std::cout << "\n22. Generar por lotes sin guardar en memoria (análisis, listado o instantánea)";
+    std::cout << "\n23. Conjunto virtual: personas calculadas a partir de (semilla, fila)";
     std::cout << "\nSeleccione una opción: ";
 }
 
 /**
- * Punto de entrada principal del programa.
+ * Muestra el análisis completo a partir del resultado de una sola pasada.
  * 
- * POR QUÉ: Iniciar la aplicación y manejar el flujo principal.
- * CÓMO: Mediante un bucle que muestra el menú y procesa la opción seleccionada.
- * PARA QUÉ: Ejecutar las funcionalidades del sistema.
+ * POR QUÉ: Las estadísticas ya están calculadas; solo falta presentarlas.
+ * CÓMO: Recorriendo las ciudades en orden alfabético y resolviendo cada fila con 'personaEnFila'
+ *       (colección en memoria o instantánea cargada).
+ * PARA QUÉ: Opción 17 del menú, con el mismo formato que las opciones individuales.
  */
-int main() {
-    srand(time(nullptr)); // Semilla para generación aleatoria
+// Códigos de las ciudades con personas, en orden alfabético (como las claves de std::map)
+static std::map<std::string, size_t> ciudadesEnOrden(const ResultadoAgregado& resultado,
+                                                     const std::vector<std::string>& nombresCiudad) {
+    std::map<std::string, size_t> ordenCiudades;
+    for (size_t c = 0; c < nombresCiudad.size() && c < resultado.ciudades.size(); ++c) {
+        if (resultado.ciudades[c].personas > 0) {
+            ordenCiudades[nombresCiudad[c]] = c;
+        }
+    }
+    return ordenCiudades;
+}
+
+void mostrarResultadoAgregado(const ResultadoAgregado& resultado,
+                              const std::function<Persona(uint64_t)>& personaEnFila,
+                              const std::vector<std::string>& nombresCiudad) {
+    std::map<std::string, size_t> ordenCiudades = ciudadesEnOrden(resultado, nombresCiudad);
+
+    std::cout << "\nLa persona más longeva es ";
+    personaEnFila(resultado.pais.filaMasLongeva).mostrarResumen();
+    std::cout << "\n\nMas longeva por ciudad:\n";
+    for (const auto& par : ordenCiudades) {
+        personaEnFila(resultado.ciudades[par.second].filaMasLongeva).mostrarResumen();
+        std::cout << "\n";
+    }
+    std::cout << "\nPromedio de edad en el país: " << resultado.pais.promedioEdad() << " años\n";
+
+    std::cout << "\n--- Ranking de Riqueza por Calendario ---\n";
+    int posicion = 1;
+    for (const auto& par : rankingCalendarios(resultado)) {
+        std::cout << posicion++ << ". Calendario '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
+    }
+    std::cout << "\n--- Ranking de Riqueza por Ciudad ---\n";
+    posicion = 1;
+    for (const auto& par : rankingCiudades(resultado, nombresCiudad)) {
+        std::cout << posicion++ << ". Ciudad '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
+    }
+
+    std::cout << "\nPersona con mayor patrimonio en el país:\n";
+    personaEnFila(resultado.pais.filaMayorPatrimonio).mostrarResumen();
+    std::cout << "\n\n--- Persona con mayor patrimonio por ciudad ---\n";
+    for (const auto& par : ordenCiudades) {
+        std::cout << par.first << ": ";
+        personaEnFila(resultado.ciudades[par.second].filaMayorPatrimonio).mostrarResumen();
+        std::cout << "\n";
+    }
+    std::cout << "\n--- Persona con mayor patrimonio por grupo ---\n";
+    for (size_t g = 0; g < 3; ++g) {
+        if (resultado.calendarios[g].personas > 0) {
+            std::cout << "Grupo " << TablaPersonas::letraCalendario(static_cast<uint8_t>(g)) << ": ";
+            personaEnFila(resultado.calendarios[g].filaMayorPatrimonio).mostrarResumen();
+            std::cout << "\n";
+        }
+    }
+
+    std::cout << "\n--- Declarantes de Renta por Calendario ---\n";
+    for (size_t g = 0; g < 3; ++g) {
+        if (resultado.calendarios[g].declarantes > 0) {
+            std::cout << "Calendario " << TablaPersonas::letraCalendario(static_cast<uint8_t>(g)) << ": "
+                      << resultado.calendarios[g].declarantes << " declarantes\n";
+        }
+    }
+}
+
+/**
+ * Muestra los declarantes de renta de cada calendario.
+ * 
+ * POR QUÉ: El resultado agregado solo guarda cuántos declarantes hay, no quiénes son.
+ * CÓMO: Reserva cada grupo con el conteo ya calculado (en 'recurso': la arena de la operación
+ *       en la versión por referencia) y recorre el bitset de declarantes palabra a palabra
+ *       (saltando las vacías) para repartir sus filas por calendario.
+ * PARA QUÉ: Opciones 8 y 9 del menú, sobre la colección en memoria o una instantánea.
+ */
+static void mostrarDeclarantes(const ResultadoAgregado& resultado, const ColumnasPersonas& columnas,
+                               const std::function<Persona(uint64_t)>& personaEnFila,
+                               std::pmr::memory_resource* recurso) {
+    std::pmr::vector<uint64_t> filas[3] = {std::pmr::vector<uint64_t>(recurso), std::pmr::vector<uint64_t>(recurso),
+                                           std::pmr::vector<uint64_t>(recurso)};
+    for (size_t g = 0; g < 3; ++g) {
+        filas[g].reserve(resultado.calendarios[g].declarantes);
+    }
+    {
+        TramoPerfil tramo("filtrar declarantes");
+        for (size_t w = 0; w * 64 < columnas.filas; ++w) {
+            uint64_t palabra = columnas.declarante[w];
+            while (palabra != 0) {
+                uint64_t fila = w * 64 + static_cast<uint64_t>(__builtin_ctzll(palabra));
+                if (fila >= columnas.filas) {
+                    break;
+                }
+                filas[columnas.calendario[fila]].push_back(fila);
+                palabra &= palabra - 1; // Apaga el bit menos significativo
+            }
+        }
+    }
+    TramoPerfil tramo("mostrar");
+    for (size_t g = 0; g < 3; ++g) {
+        if (resultado.calendarios[g].declarantes == 0) {
+            continue;
+        }
+        std::cout << "\n";
+        std::cout << "--------- Calendario " << TablaPersonas::letraCalendario(static_cast<uint8_t>(g)) << ": "
+                  << resultado.calendarios[g].declarantes << " declarantes---------\n";
+        std::cout << "\n";
+        for (uint64_t fila : filas[g]) {
+            personaEnFila(fila).mostrarResumen();
+            std::cout << "\n";
+        }
+    }
+}
+
+/**
+ * Submenú de mayor patrimonio (país, ciudad o grupo) a partir del resultado agregado.
+ * 
+ * POR QUÉ: Las filas con mayor patrimonio ya salen de la pasada fusionada.
+ * CÓMO: Lee el ámbito de std::cin y muestra la fila guardada de cada grupo.
+ * PARA QUÉ: Opciones 14 y 15 del menú, con el mismo formato que Persona::mostrarMayorPatrimonio*.
+ */
+static void mostrarMayorPatrimonio(const ResultadoAgregado& resultado,
+                                   const std::function<Persona(uint64_t)>& personaEnFila,
+                                   const std::vector<std::string>& nombresCiudad) {
+    std::cout << "\n--- Menú Patrimonio ---\n";
+    std::cout << "1. Mayor patrimonio en el país\n";
+    std::cout << "2. Mayor patrimonio por ciudad\n";
+    std::cout << "3. Mayor patrimonio por grupo (A/B/C)\n";
+    int subop;
+    std::cout << "\nSeleccione una opción: ";
+    std::cin >> subop;
+
+    if (subop == 1) {
+        std::cout << "Persona con mayor patrimonio en el país:\n";
+        personaEnFila(resultado.pais.filaMayorPatrimonio).mostrarResumen();
+        std::cout << " Patrimonio: " << resultado.pais.mayorPatrimonio << "\n";
+    } else if (subop == 2) {
+        std::cout << "\n--- Persona con mayor patrimonio por ciudad ---\n";
+        for (const auto& par : ciudadesEnOrden(resultado, nombresCiudad)) {
+            const EstadisticaGrupo& ciudad = resultado.ciudades[par.second];
+            std::cout << par.first << ": la persona con mayor patrimonio es ";
+            personaEnFila(ciudad.filaMayorPatrimonio).mostrarResumen();
+            std::cout << " con patrimonio: $" << ciudad.mayorPatrimonio << "\n";
+        }
+    } else if (subop == 3) {
+        std::cout << "\n--- Persona con mayor patrimonio por grupo ---\n";
+        for (size_t g = 0; g < 3; ++g) {
+            const EstadisticaGrupo& grupo = resultado.calendarios[g];
+            if (grupo.personas == 0) {
+                continue;
+            }
+            std::cout << "Grupo " << TablaPersonas::letraCalendario(static_cast<uint8_t>(g))
+                      << ": la persona con mayor patrimonio es ";
+            personaEnFila(grupo.filaMayorPatrimonio).mostrarResumen();
+            std::cout << " con patrimonio: $" << grupo.mayorPatrimonio << "\n";
+        }
+    }
+}
+
+// Número de opciones del menú (0 a 23)
+static constexpr int NUM_OPCIONES = 24;
+
+// Nombre de cada opción en el monitor (registros y perfil por tramos)
+static const char* nombreOpcion(int opcion) {
+    static const char* nombres[] = {
+        "Crear datos", "Mostrar resumen", "Mostrar detalle", "Buscar por ID", "Mostrar estadisticas",
+        "Exportar CSV", "Longevo valor", "Longevo referencia", "Declarantes valor", "Declarantes referencia",
+        "Ranking grupo valor", "Ranking grupo referencia", "Ranking ciudad valor", "Ranking ciudad referencia",
+        "Patrimonio valor", "Patrimonio referencia", "Salir", "Analisis una pasada",
+        "Analisis paralelo", "Guardar instantanea", "Cargar instantanea",
+        "Repetir opcion", "Generar por lotes", "Conjunto virtual"
+    };
+    return opcion >= 0 && opcion < NUM_OPCIONES ? nombres[opcion] : "Opcion invalida";
+}
+
+/**
+ * Estado de una sesión de trabajo.
+ * 
+ * POR QUÉ: Los datos y las estructuras derivadas eran variables locales de main(), así que
+ *          solo el bucle del menú podía ejecutar operaciones.
+ * CÓMO: Agrupándolos en una estructura que se pasa a ejecutarOpcion.
+ * PARA QUÉ: Ejecutar las mismas opciones desde el menú interactivo o desde un guion (modo lote).
+ */
+struct Sesion {
+    // Monitor para medir rendimiento; va primero para que sus contadores (heredables) existan
+    // antes de crear los hilos del pool
+    Monitor monitor;
+    
+    explicit Sesion(bool contadores = false)
+        : monitor(contadores), idConsultaID(monitor.internar("consulta por ID")) {
+        for (int opcion = 0; opcion <= NUM_OPCIONES; ++opcion) {
+            idsOpcion[opcion] = monitor.internar(nombreOpcion(opcion)); // La última: opción inválida
+        }
+    }
+    
+    // Nombre de la medición de cada búsqueda por ID, internado una sola vez
+    uint32_t idConsultaID;
+    
+    // Nombre de la medición de cada opción, internado una sola vez
+    uint32_t idsOpcion[NUM_OPCIONES + 1];
+    uint32_t idOpcion(int opcion) const {
+        return idsOpcion[opcion >= 0 && opcion < NUM_OPCIONES ? opcion : NUM_OPCIONES];
+    }
+    
+    // Memoria de la colección de personas: se reinicia entera al regenerar o cargar datos.
+    // Va antes que 'personas' para destruirse después.
+    Arena arenaDatos;
+    
+    // Memoria de las vistas de cada opción: se reinicia al empezar la siguiente
+    Arena arenaOperacion;
     
     // Puntero inteligente para gestionar la colección de personas
     // POR QUÉ: Evitar fugas de memoria y garantizar liberación automática.
-    std::unique_ptr<std::vector<Persona>> personas = nullptr;
+    std::unique_ptr<ColeccionPersonas> personas = nullptr;
     
-    Monitor monitor; // Monitor para medir rendimiento
+    // Tabla columnar alineada con 'personas' (fila i = persona i)
+    TablaPersonas tabla;
     
-    int opcion;
-    do {
-        mostrarMenu();
-        std::cin >> opcion;
-        
-        // Variables locales para uso en los casos
-        size_t tam = 0;
-        int indice;
-        std::string idBusqueda;
-        
-        // Iniciar medición de tiempo y memoria para la operación actual
-        monitor.iniciar_tiempo();
-        long memoria_inicio = monitor.obtener_memoria();
-        
-        switch(opcion) {
-            case 0: { // Crear nuevo conjunto de datos
-                int n;
-                std::cout << "\nIngrese el número de personas a generar: ";
-                std::cin >> n;
-                
-                if (n <= 0) {
-                    std::cout << "Error: Debe generar al menos 1 persona\n";
-                    break;
-                }
-                
-                // Generar el nuevo conjunto de personas
-                auto nuevasPersonas = generarColeccion(n);
-                tam = nuevasPersonas.size();
-                
-                // Mover el conjunto al puntero inteligente (propiedad única)
-                personas = std::make_unique<std::vector<Persona>>(std::move(nuevasPersonas));
-                
-                // Medir tiempo y memoria usada
-                double tiempo_gen = monitor.detener_tiempo();
-                long memoria_gen = monitor.obtener_memoria() - memoria_inicio;
-                
-                std::cout << "Generadas " << tam << " personas en " 
-                          << tiempo_gen << " ms, Memoria: " << memoria_gen << " KB\n";
-                
-                // Registrar la operación
-                monitor.registrar("Crear datos", tiempo_gen, memoria_gen);
+    // Índice hash de IDs, reconstruido con cada conjunto de datos
+    IndiceID indiceIDs;
+    
+    // Resultado del análisis de una sola pasada; se calcula la primera vez que se pide
+    std::unique_ptr<ResultadoAgregado> agregado = nullptr;
+    
+    // Hilos de trabajo para la generación de datos
+    PoolHilos poolHilos;
+    
+    // Instantánea binaria cargada; mientras no se materialice, el análisis lee sus columnas
+    Instantanea instantanea;
+};
+
+/**
+ * Ejecuta una opción del menú sobre la sesión.
+ * 
+ * POR QUÉ: Separar qué hace cada opción de cómo se elige (menú o guion).
+ * CÓMO: Las opciones leen sus parámetros de std::cin; el modo lote redirige std::cin a
+ *       un flujo con las respuestas del comando.
+ *       Cada opción es el tramo raíz de su perfil y registra una sola medición.
+ * PARA QUÉ: Un único código por opción para el uso interactivo y el desatendido.
+ */
+void ejecutarOpcion(Sesion& sesion, int opcion) {
+    auto& personas = sesion.personas;
+    auto& tabla = sesion.tabla;
+    auto& indiceIDs = sesion.indiceIDs;
+    auto& agregado = sesion.agregado;
+    auto& poolHilos = sesion.poolHilos;
+    auto& instantanea = sesion.instantanea;
+    auto& monitor = sesion.monitor;
+    Arena& arenaOperacion = sesion.arenaOperacion;
+    arenaOperacion.reiniciar(); // Nada de la opción anterior sigue vivo
+    
+    // Fuente columnar activa y persona de una fila (colección en memoria o instantánea)
+    auto columnasActivas = [&]() { return instantanea.abierta() ? instantanea.columnas() : tabla.columnas(); };
+    auto ciudadesActivas = [&]() -> const std::vector<std::string>& {
+        return instantanea.abierta() ? instantanea.getCiudades() : tabla.getCiudades();
+    };
+    auto personaEnFila = [&](uint64_t fila) { return personas ? (*personas)[fila] : instantanea.persona(fila); };
+    
+    // Resultado de la pasada fusionada: se calcula la primera vez y lo comparten las opciones 6 a 18
+    auto resultadoActivo = [&]() -> const ResultadoAgregado& {
+        if (!agregado) {
+            agregado = std::make_unique<ResultadoAgregado>(
+                agregarEnUnaPasada(columnasActivas(), ciudadesActivas().size()));
+        }
+        return *agregado;
+    };
+    
+    // Variables locales para uso en los casos
+    size_t tam = 0;
+    int indice;
+    std::string idBusqueda;
+    
+    // Iniciar medición de tiempo y memoria para la operación actual
+    monitor.iniciar_tiempo();
+    long memoria_inicio = monitor.obtener_memoria();
+    size_t registros_inicio = monitor.num_registros();
+    TramoPerfil tramoOpcion(monitor, nombreOpcion(opcion));
+    MedicionRapida medicionOpcion(monitor, sesion.idOpcion(opcion));
+    
+    // Listado, detalle, búsqueda y guardado necesitan la colección: se reconstruye desde la
+    // instantánea cargada la primera vez que se pide una de ellas (el análisis lee sus columnas)
+    if (((opcion >= 1 && opcion <= 3) || opcion == 19) && !personas && instantanea.abierta()) {
+        TramoPerfil tramo("materializar instantanea");
+        auto materializadas = std::make_unique<ColeccionPersonas>(&sesion.arenaDatos);
+        instantanea.materializar(*materializadas, tabla, poolHilos);
+        personas = std::move(materializadas);
+        indiceIDs.construir(*personas);
+        std::cout << "\n(" << personas->size() << " personas reconstruidas desde la instantánea)\n";
+    }
+    
+    switch(opcion) {
+        case 0: { // Crear nuevo conjunto de datos
+            int n;
+            std::cout << "\nIngrese el número de personas a generar: ";
+            std::cin >> n;
+            
+            if (n <= 0) {
+                std::cout << "Error: Debe generar al menos 1 persona\n";
                 break;
             }
-                
-            case 1: { // Mostrar resumen de todas las personas
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }
-                
-                tam = personas->size();
-                std::cout << "\n=== RESUMEN DE PERSONAS (" << tam << ") ===\n";
-                for(size_t i = 0; i < tam; ++i) {
-                    std::cout << i << ". ";
-                    (*personas)[i].mostrarResumen();
-                    std::cout << "\n";
-                }
-                
-                double tiempo_mostrar = monitor.detener_tiempo();
-                long memoria_mostrar = monitor.obtener_memoria() - memoria_inicio;
+            
+            uint64_t semilla;
+            std::cout << "Semilla (0 = aleatoria): ";
+            std::cin >> semilla;
+            if (semilla == 0) {
+                semilla = semillaAleatoria();
+            }
+            
+            // El conjunto anterior se descarta antes de generar: su memoria de la arena se
+            // reutiliza de una vez para el nuevo
+            personas.reset();
+            indiceIDs.limpiar();
+            sesion.arenaDatos.reiniciar();
+            
+            // Generar el nuevo conjunto de personas (misma semilla = mismos datos)
+            auto nuevasPersonas = generarColeccion(static_cast<size_t>(n), semilla, tabla, poolHilos,
+                                                   &sesion.arenaDatos);
+            tam = nuevasPersonas.size();
+            
+            // Mover el conjunto al puntero inteligente (propiedad única; mismo recurso, sin copia)
+            personas = std::make_unique<ColeccionPersonas>(std::move(nuevasPersonas));
+            indiceIDs.construir(*personas);
+            agregado.reset(); // El análisis anterior ya no corresponde a los datos
+            instantanea.cerrar(); // Los datos activos son los recién generados
+            
+            // Medir tiempo y memoria usada
+            double tiempo_gen = monitor.detener_tiempo();
+            long memoria_gen = monitor.obtener_memoria() - memoria_inicio;
+            
+            std::cout << "Generadas " << tam << " personas en " 
+                      << tiempo_gen << " ms, Memoria: " << memoria_gen << " KB"
+                      << " (semilla " << semilla << ", " << poolHilos.numHilos() << " hilos)\n";
+            
+            // Registrar la operación
+            monitor.registrar("Crear datos", tiempo_gen, memoria_gen);
+            break;
+        }
+            
+        case 1: { // Mostrar resumen de todas las personas
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }
+            
+            tam = personas->size();
+            int modo;
+            std::cout << "\n1. Todas  2. Rango de filas  3. Primeras N\nSeleccione: ";
+            std::cin >> modo;
+            
+            // Filas [desde, hasta) a mostrar
+            size_t desde = 0, hasta = tam;
+            if (modo == 2) {
+                std::cout << "Fila inicial (0-" << tam - 1 << "): ";
+                std::cin >> desde;
+                std::cout << "Fila final (inclusive): ";
+                std::cin >> hasta;
+                hasta = hasta < tam ? hasta + 1 : tam;
+            } else if (modo == 3) {
+                std::cout << "Cantidad de filas: ";
+                std::cin >> hasta;
+                hasta = std::min(hasta, tam);
+            }
+            if (desde >= hasta) {
+                std::cout << "Error: Rango vacío\n";
+                break;
+            }
+            
+            std::cout << "\n=== RESUMEN DE PERSONAS (" << hasta - desde << " de " << tam << ") ===\n";
+            size_t filas_mostradas;
+            int error_salida;
+            {
+                TramoPerfil tramo("mostrar");
+                Renderizador salida;
+                filas_mostradas = salida.listar(*personas, desde, hasta);
+                salida.vaciar(); // Antes de cerrar el tramo y de consultar el error
+                error_salida = salida.error();
+            }
+            
+            double tiempo_mostrar = monitor.detener_tiempo();
+            long memoria_mostrar = monitor.obtener_memoria() - memoria_inicio;
+            if (error_salida != 0) {
+                std::cerr << "Error al escribir el listado: " << std::strerror(error_salida) << std::endl;
                 monitor.registrar("Mostrar resumen", tiempo_mostrar, memoria_mostrar);
                 break;
             }
-                
-            case 2: { // Mostrar detalle por índice
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }
-                
-                tam = personas->size();
-                std::cout << "\nIngrese el índice (0-" << tam-1 << "): ";
-                if(std::cin >> indice) {
-                    if(indice >= 0 && static_cast<size_t>(indice) < tam) {
-                        (*personas)[indice].mostrar();
-                    } else {
-                        std::cout << "Índice fuera de rango!\n";
-                    }
-                } else {
-                    std::cout << "Entrada inválida!\n";
-                    std::cin.clear();
-                    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                }
-                
-                double tiempo_detalle = monitor.detener_tiempo();
-                long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar detalle", tiempo_detalle, memoria_detalle);
+            monitor.registrar("Mostrar resumen", tiempo_mostrar, memoria_mostrar, filas_mostradas);
+            monitor.mostrar_rendimiento("Mostrar resumen", filas_mostradas, tiempo_mostrar);
+            break;
+        }
+            
+        case 2: { // Mostrar detalle por índice
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
-                
-            case 3: { // Buscar por ID
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
-                    break;
-                }
-                
-                std::cout << "\nIngrese el ID a buscar: ";
-                std::cin >> idBusqueda;
-                
-                if(const Persona* encontrada = buscarPorID(*personas, idBusqueda)) {
-                    encontrada->mostrar();
+            
+            tam = personas->size();
+            std::cout << "\nIngrese el índice (0-" << tam-1 << "): ";
+            if(std::cin >> indice) {
+                if(indice >= 0 && static_cast<size_t>(indice) < tam) {
+                    (*personas)[indice].mostrar();
                 } else {
-                    std::cout << "No se encontró persona con ID " << idBusqueda << "\n";
+                    std::cout << "Índice fuera de rango!\n";
                 }
-                
-                double tiempo_busqueda = monitor.detener_tiempo();
-                long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Buscar por ID", tiempo_busqueda, memoria_busqueda);
-                break;
+            } else {
+                std::cout << "Entrada inválida!\n";
+                std::cin.clear();
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
             }
-                
-            case 4: // Mostrar estadísticas de rendimiento
-                monitor.mostrar_resumen();
+            
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Mostrar detalle", tiempo_detalle, memoria_detalle);
+            break;
+        }
+            
+        case 3: { // Buscar por ID
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }
+            
+            std::cout << "\nIngrese el ID a buscar: ";
+            std::cin >> idBusqueda;
+            
+            uint64_t idNumerico = 0;
+            const Persona* encontrada = nullptr;
+            {
+                // Latencia de la consulta sola (sin leer la entrada ni mostrar la persona)
+                MedicionRapida medicion(monitor, sesion.idConsultaID);
+                encontrada = convertirID(idBusqueda, idNumerico) ? buscarPorID(*personas, indiceIDs, idNumerico)
+                                                                 : nullptr;
+            }
+            if(encontrada) {
+                encontrada->mostrar();
+            } else {
+                std::cout << "No se encontró persona con ID " << idBusqueda << "\n";
+            }
+            
+            double tiempo_busqueda = monitor.detener_tiempo();
+            long memoria_busqueda = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Buscar por ID", tiempo_busqueda, memoria_busqueda);
+            break;
+        }
             
-            case 5: // Exportar estadísticas a CSV
-                monitor.exportar_csv();
+        case 4: // Mostrar estadísticas de rendimiento
+            monitor.mostrar_resumen();
+            break;
+        
+        case 5: // Exportar estadísticas a CSV y la traza de tramos
+            monitor.exportar_csv();
+            monitor.exportar_traza();
+            break;
+
+        case 6: { //mas longevo por ciudad - valor
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }
+            ResultadoAgregado resultado = resultadoActivo(); // Por valor: copia del resultado
+            personaEnFila(resultado.pais.filaMasLongeva).mostrarResumen();
+            std::cout << "\nMas longeva por ciudad:\n";
+            for (const auto& par : ciudadesEnOrden(resultado, ciudadesActivas())) {
+                personaEnFila(resultado.ciudades[par.second].filaMasLongeva).mostrarResumen();
+                std::cout << "\n"; 
+            }
+            std::cout << "\nPromedio de edad en el país (valor):\n";
+            double promedio = resultado.pais.promedioEdad();
+            std::cout << promedio << " años\n";
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Longevo valor", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
-            case 6: { //mas longevo por ciudad - valor
-                Persona vieja = Persona::edadMasLongevaPais(*personas);
-                vieja.mostrarResumen();
-                std::cout << "\nMas longeva por ciudad:\n";
-                std::vector<Persona> viejaCiudad = Persona::edadMasLongevaCiudad(*personas);
-                for (const auto& persona : viejaCiudad) {
-                    persona.mostrarResumen();
-                    std::cout << "\n"; 
-                }
-                std::cout << "\nPromedio de edad en el país (valor):\n";
-                double promedio = Persona::promedioEdadPais(*personas);
-                std::cout << promedio << " años\n";
-                double tiempo_detalle = monitor.detener_tiempo();
-                long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Longevo valor", tiempo_detalle, memoria_detalle);
+        case 7:{ //Mas longevo por ciudad - referencia
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
+            const ResultadoAgregado& resultado = resultadoActivo();
+            std::cout << "\nUsando referencias:\n";
+            std::cout << "La persona más longeva es ";
+            personaEnFila(resultado.pais.filaMasLongeva).mostrarResumen();
+            std::cout << "\nUsando referencias por ciudad:\n";
+            for (const auto& par : ciudadesEnOrden(resultado, ciudadesActivas())) {
+                personaEnFila(resultado.ciudades[par.second].filaMasLongeva).mostrarResumen();
+                std::cout << "\n";
+            }
+            std::cout << "\nPromedio de edad en el país (referencia):\n";
+            std::cout << resultado.pais.promedioEdad();
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Longevo referencia", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
-            case 7:{ //Mas longevo por ciudad - referencia
-                std::cout << "\nUsando referencias:\n";
-                Persona::edadMasLongevaPaisRef(*personas);
-                std::cout << "\nUsando referencias por ciudad:\n";
-                Persona::edadMasLongevaCiudadRef(*personas);
-                std::cout << "\nPromedio de edad en el país (referencia):\n";
-                Persona::promedioEdadPaisRef(*personas);
-                double tiempo_detalle = monitor.detener_tiempo();
-                long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Longevo referencia", tiempo_detalle, memoria_detalle);
+        case 8: { //Declarantes de renta - Valor
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
+            ResultadoAgregado resultado = resultadoActivo();
+            std::cout << "\n--- Declarantes de Renta por Calendario ---\n";
+            mostrarDeclarantes(resultado, columnasActivas(), personaEnFila, std::pmr::get_default_resource());
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Declarantes valor", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
-            case 8: { //Declarantes de renta - Valor
-                std::map<std::string, std::vector<Persona>> agrupacion = Persona::agruparCalendario(*personas);
-                auto declarantes = Persona::declarantesRenta(agrupacion);
-                std::cout << "\n--- Declarantes de Renta por Calendario ---\n";
-                for (const auto& grupo : declarantes) {
-                    std::cout << "\n";
-                    std::cout << "--------- Calendario " << grupo.first << ": " << grupo.second.size() << " declarantes---------\n";
-                    std::cout << "\n";
-                    for (const Persona& persona : grupo.second) {
-                        persona.mostrarResumen();
-                        std::cout << "\n";
-                    }
-                }
+        case 9:{ //Declarantes de renta - Referencia
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
-   
-            }
-
-            case 9:{ //Declarantes de renta - Referencia
-                std::map<std::string, std::vector<Persona>> calendarioAgrupado;
-                Persona::agruparCalendarioRef(*personas, calendarioAgrupado);
-                std::map<std::string, std::vector<Persona>> declarantes;
-                Persona::declarantesRentaRef(calendarioAgrupado, declarantes);
-                std::cout << "\n--- Declarantes de Renta por Calendario (Referencia) ---\n";
-                for (const auto& grupo : declarantes) {
-                    std::cout << "\n";
-                    std::cout << "--------- Calendario " << grupo.first << ": " << grupo.second.size() << " declarantes---------\n";
-                    std::cout << "\n";
-                    for (const Persona& persona : grupo.second) {
-                        persona.mostrarResumen();
-                        std::cout << "\n";
-                    }
-                }
+            }
+            const ResultadoAgregado& resultado = resultadoActivo();
+            std::cout << "\n--- Declarantes de Renta por Calendario (Referencia) ---\n";
+            mostrarDeclarantes(resultado, columnasActivas(), personaEnFila, &arenaOperacion);
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Declarantes referencia", tiempo_detalle, memoria_detalle);
+            break;
+        }
+
+        case 10: { //Ranking de riqueza por agrupación - Valor
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
+            ResultadoAgregado resultado = resultadoActivo();
+            auto ranking = rankingCalendarios(resultado);
+            std::cout << "\n--- Ranking de Riqueza por Calendario ---\n";
+            int posicion = 1;
+            for (const auto& par : ranking) {
+                std::cout << posicion << ". Calendario '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
+                posicion++;
+            }
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Ranking grupo valor", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
-            case 10: { //Ranking de riqueza por agrupación - Valor
-                std::map<std::string, std::vector<Persona>> agrupacion = Persona::agruparCalendario(*personas);
-                auto ranking = Persona::rankingRiqueza(agrupacion);
-                std::cout << "\n--- Ranking de Riqueza por Calendario ---\n";
-                int posicion = 1;
-                for (const auto& par : ranking) {
-                    std::cout << posicion << ". Calendario '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
-                    posicion++;
-                }
-                double tiempo_detalle = monitor.detener_tiempo();
-                long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar detalle", tiempo_detalle, memoria_detalle);
+        case 11:{ //Ranking de riqueza por agrupación - Referencia
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
+            const ResultadoAgregado& resultado = resultadoActivo();
+            std::vector<std::pair<std::string, double>> ranking = rankingCalendarios(resultado);
+            std::cout << "\n--- Ranking de Riqueza por Calendario (Referencia) ---\n";
+            int posicionRef = 1;
+            for (const auto& par : ranking) {
+                std::cout << posicionRef << ". Calendario '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
+                posicionRef++;
+            }
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Ranking grupo referencia", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
-            case 11:{ //Ranking de riqueza por agrupación - Referencia
-                std::map<std::string, std::vector<Persona>> calendarioAgrupado;
-                Persona::agruparCalendarioRef(*personas, calendarioAgrupado);
-                std::vector<std::pair<std::string, double>> ranking;
-                Persona::rankingRiquezaRef(calendarioAgrupado, ranking);
-                std::cout << "\n--- Ranking de Riqueza por Calendario (Referencia) ---\n";
-                int posicionRef = 1;
-                for (const auto& par : ranking) {
-                    std::cout << posicionRef << ". Calendario '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
-                    posicionRef++;
-                }
+        case 12: { //Ranking de riqueza por ciudad - Valor
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
+            }
+            ResultadoAgregado resultado = resultadoActivo();
+            auto rankingCiudad = rankingCiudades(resultado, ciudadesActivas());
+            std::cout << "\n--- Ranking de Riqueza por Ciudad ---\n";
+            int posicionCiudad = 1;
+            for (const auto& par : rankingCiudad) {
+                std::cout << posicionCiudad << ". Ciudad '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
+                posicionCiudad++;
+            }
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Ranking ciudad valor", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
+        case 13: { //Ranking de riqueza por ciudad - Referencia
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }
+            const ResultadoAgregado& resultado = resultadoActivo();
+            std::vector<std::pair<std::string, double>> rankingCiudadRef = rankingCiudades(resultado, ciudadesActivas());
+            std::cout << "\n--- Ranking de Riqueza por Ciudad (Referencia) ---\n";
+            int posicionCiudadRef = 1;
+            for (const auto& par : rankingCiudadRef) {
+                std::cout << posicionCiudadRef << ". Ciudad '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
+                posicionCiudadRef++;
             }
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Ranking ciudad referencia", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
-            case 12: { //Ranking de riqueza por ciudad - Valor
-                std::map<std::string, std::vector<Persona>> ciudad = Persona::agruparCiudad(*personas);
-                auto rankingCiudad = Persona::rankingRiquezaCiudad(ciudad);
-                std::cout << "\n--- Ranking de Riqueza por Ciudad ---\n";
-                int posicionCiudad = 1;
-                for (const auto& par : rankingCiudad) {
-                    std::cout << posicionCiudad << ". Ciudad '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
-                    posicionCiudad++;
-                }
+
+        case 14: { // Mayor patrimonio - Valor
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
+            ResultadoAgregado resultado = resultadoActivo();
+            mostrarMayorPatrimonio(resultado, personaEnFila, ciudadesActivas());
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Patrimonio valor", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
-            case 13: { //Ranking de riqueza por ciudad - Referencia
-                std::map<std::string, std::vector<Persona>> ciudadAgrupada;
-                Persona::agruparCiudadRef(*personas, ciudadAgrupada);
-                std::vector<std::pair<std::string, double>> rankingCiudadRef;
-                Persona::rankingRiquezaCiudadRef(ciudadAgrupada, rankingCiudadRef);
-                std::cout << "\n--- Ranking de Riqueza por Ciudad (Referencia) ---\n";
-                int posicionCiudadRef = 1;
-                for (const auto& par : rankingCiudadRef) {
-                    std::cout << posicionCiudadRef << ". Ciudad '" << par.first << "': Suma de ingresos = " << par.second << std::endl;
-                    posicionCiudadRef++;
-                }
-                
+        case 15: { // Mayor patrimonio - Referencia
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }
+            mostrarMayorPatrimonio(resultadoActivo(), personaEnFila, ciudadesActivas());
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Patrimonio referencia", tiempo_detalle, memoria_detalle);
+            break;
+        }
+
+        case 16: // Salir
+            std::cout << "Saliendo...\n";
+            break;
+
+        case 17: { // Análisis completo en una sola pasada
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
                 break;
             }
+            bool calculado = !agregado;
+            std::cout << "\n--- Análisis en una pasada (" << columnasActivas().filas << " filas, "
+                      << (calculado ? "recién calculado" : "resultado en memoria") << ") ---\n";
+            mostrarResultadoAgregado(resultadoActivo(), personaEnFila, ciudadesActivas());
 
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Analisis una pasada", tiempo_detalle, memoria_detalle);
+            break;
+        }
 
-            case 14: { // Mayor patrimonio - Valor
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        case 18: { // Análisis paralelo con distintos números de hilos
+            if ((!personas || personas->empty()) && !instantanea.abierta()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }
+            size_t maxHilos = 0;
+            std::cout << "\nNúmero máximo de hilos (0 = " << PoolHilos::hilosDisponibles() << " disponibles): ";
+            std::cin >> maxHilos;
+            if (maxHilos == 0) {
+                maxHilos = PoolHilos::hilosDisponibles();
+            }
+
+            // Referencia secuencial para verificar que el resultado no cambia
+            const ResultadoAgregado& secuencial = resultadoActivo();
+
+            // Barrido 1, 2, 4, ... hasta maxHilos (incluido)
+            for (size_t hilos = 1; ; hilos = std::min(hilos * 2, maxHilos)) {
+                PoolHilos pool(hilos); // Crear los hilos no forma parte de la medición
+                ResultadoAgregado resultado;
+                double tiempo_hilos;
+                {
+                    TramoPerfil tramo("agregar en paralelo");
+                    resultado = agregarParalelo(columnasActivas(), ciudadesActivas().size(), pool);
+                    tiempo_hilos = tramo.transcurrido();
+                }
+                monitor.registrar_aceleracion("Analisis paralelo", hilos, tiempo_hilos);
+                std::cout << "\n" << hilos << " hilos: " << tiempo_hilos << " ms, resultado "
+                          << (resultadosIguales(resultado, secuencial) ? "idéntico" : "DISTINTO")
+                          << " al secuencial";
+                if (hilos == maxHilos) {
                     break;
                 }
-                Persona::mostrarMayorPatrimonioPorValor(*personas);
+            }
+            std::cout << "\n";
+            monitor.mostrar_aceleracion();
+            double tiempo_detalle = monitor.detener_tiempo();
+            long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Analisis paralelo", tiempo_detalle, memoria_detalle);
+            break;
+        }
+
+        case 19: { // Guardar instantánea binaria
+            if (!personas || personas->empty()) {
+                std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                break;
+            }
+            std::string ruta;
+            std::cout << "\nArchivo de destino: ";
+            std::cin >> ruta;
+            if (Instantanea::guardar(ruta, *personas, tabla)) {
+                std::cout << "Guardadas " << personas->size() << " personas en " << ruta << "\n";
+            }
+            
+            double tiempo_guardar = monitor.detener_tiempo();
+            long memoria_guardar = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Guardar instantanea", tiempo_guardar, memoria_guardar);
+            break;
+        }
+
+        case 20: { // Cargar instantánea binaria
+            std::string ruta;
+            std::cout << "\nArchivo a cargar: ";
+            std::cin >> ruta;
+            // Se abre aparte: si el archivo no es válido, la sesión no se toca
+            Instantanea cargada;
+            if (!cargada.abrir(ruta)) {
+                break; // abrir() ya informó el error; los datos anteriores siguen activos
+            }
+            // La instantánea pasa a ser el conjunto activo
+            personas.reset();
+            sesion.arenaDatos.reiniciar();
+            tabla.limpiar();
+            indiceIDs.limpiar();
+            agregado.reset();
+            instantanea = std::move(cargada);
+            
+            double tiempo_cargar = monitor.detener_tiempo();
+            long memoria_cargar = monitor.obtener_memoria() - memoria_inicio;
+            std::cout << "Cargadas " << instantanea.tamano() << " personas en " << tiempo_cargar << " ms\n";
+            monitor.registrar("Cargar instantanea", tiempo_cargar, memoria_cargar);
+            break;
+        }
+
+        case 21: { // Repetir una opción: calentamiento + N ejecuciones medidas
+            int objetivo;
+            size_t calentamiento = 0, repeticiones = 0;
+            std::cout << "\nOpción a repetir: ";
+            std::cin >> objetivo;
+            std::cout << "Ejecuciones de calentamiento: ";
+            std::cin >> calentamiento;
+            std::cout << "Ejecuciones medidas: ";
+            std::cin >> repeticiones;
+            if (!std::cin) {
+                break;
+            }
+            // Las opciones que muestran o exportan el monitor, el barrido de hilos (mide por sí
+            // mismo), Salir y la propia repetición no tienen sentido repetidas
+            if (objetivo < 0 || objetivo >= NUM_OPCIONES || objetivo == 4 || objetivo == 5 || objetivo == 16 ||
+                objetivo == 18 || objetivo == 21) {
+                std::cout << "Opción no repetible: " << objetivo << "\n";
                 break;
-                double tiempo_detalle = monitor.detener_tiempo();
-                long memoria_detalle = monitor.obtener_memoria() - memoria_inicio;
-                monitor.registrar("Mostrar detalle", tiempo_detalle, memoria_detalle);
             }
+            if (repeticiones == 0) {
+                std::cout << "Se necesita al menos una ejecución medida.\n";
+                break;
+            }
+            // Las respuestas de la opción (lo que pediría por teclado) van en una sola línea
+            std::string respuestas;
+            std::cout << "Respuestas de la opción en una línea (vacía si no pide nada): ";
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            std::getline(std::cin, respuestas);
+            
+            bool faltaronDatos = false;
+            EstadisticasTiempo estadisticas = monitor.repetir(
+                std::string(nombreOpcion(objetivo)) + " x" + std::to_string(repeticiones), calentamiento,
+                repeticiones, [&]() {
+                    std::istringstream entrada(respuestas);
+                    std::streambuf* teclado = std::cin.rdbuf(entrada.rdbuf());
+                    std::cin.clear();
+                    ejecutarOpcion(sesion, objetivo);
+                    faltaronDatos = faltaronDatos || std::cin.fail();
+                    std::cin.rdbuf(teclado);
+                    std::cin.clear();
+                });
+            if (faltaronDatos) {
+                std::cout << "Aviso: faltaron respuestas para la opción " << objetivo << "\n";
+            }
+            std::streamsize precision = std::cout.precision(4); // Microsegundos visibles
+            std::cout << "\n" << nombreOpcion(objetivo) << ": mediana " << estadisticas.mediana << " ms, media "
+                      << estadisticas.media << " ± " << estadisticas.intervalo95 << " ms (IC 95 %), p99 "
+                      << estadisticas.p99 << " ms\n";
+            std::cout.precision(precision);
+            break;
+        }
 
-            case 15: { // Mayor patrimonio - Referencia
-                if (!personas || personas->empty()) {
-                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        case 22: { // Generar por lotes: los datos se consumen mientras se generan
+            uint64_t n = 0, semilla = 0;
+            size_t tamLote = 0;
+            int destino = 0;
+            std::string ruta;
+            std::cout << "\nNúmero de personas (no necesita caber en memoria): ";
+            std::cin >> n;
+            std::cout << "Semilla (0 = aleatoria): ";
+            std::cin >> semilla;
+            std::cout << "Personas por lote: ";
+            std::cin >> tamLote;
+            std::cout << "1. Análisis en una pasada  2. Listado a archivo  3. Instantánea binaria\nSeleccione: ";
+            std::cin >> destino;
+            if (destino == 2 || destino == 3) {
+                std::cout << "Archivo de destino: ";
+                std::cin >> ruta;
+            }
+            if (!std::cin || n == 0 || tamLote == 0 || destino < 1 || destino > 3) {
+                std::cout << "Error: Datos inválidos\n";
+                break;
+            }
+            if (semilla == 0) {
+                semilla = semillaAleatoria();
+            }
+
+            uint64_t procesadas = 0;
+            if (destino == 1) {
+                AgregadorPorLotes agregador(ciudadesGenerador().size());
+                procesadas = generarPorLotes(n, semilla, tamLote, poolHilos, [&](const LotePersonas& lote) {
+                    agregador.agregar(lote.tabla.columnas(), lote.primeraFila);
+                    return true;
+                });
+                std::cout << "\n--- Análisis por lotes (" << procesadas << " filas, semilla " << semilla << ") ---\n";
+                // Las filas no se guardan: cada persona mostrada se vuelve a generar desde (semilla, fila)
+                mostrarResultadoAgregado(agregador.terminar(),
+                                         [semilla](uint64_t fila) { return generarPersona(semilla, fila); },
+                                         ciudadesGenerador());
+            } else if (destino == 2) {
+                int fd = open(ruta.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                if (fd < 0) {
+                    std::cerr << "Error al abrir archivo: " << ruta << std::endl;
                     break;
                 }
-                Persona::mostrarMayorPatrimonioPorReferencia(std::make_unique<std::vector<Persona>>(*personas));
-                break;
+                int error_salida;
+                {
+                    Renderizador salida(fd);
+                    procesadas = generarPorLotes(n, semilla, tamLote, poolHilos, [&](const LotePersonas& lote) {
+                        TramoPerfil tramo("listar lote");
+                        salida.listar(lote.personas, 0, lote.personas.size(), lote.primeraFila);
+                        return salida.correcto(); // Tras un error de escritura no se generan más lotes
+                    });
+                    salida.vaciar();
+                    error_salida = salida.error();
+                }
+                close(fd);
+                if (error_salida != 0) {
+                    std::cerr << "Error al escribir " << ruta << ": " << std::strerror(error_salida) << std::endl;
+                    break;
+                }
+            } else {
+                EscritorInstantanea escritor;
+                if (!escritor.abrir(ruta, n, ciudadesGenerador())) {
+                    break;
+                }
+                procesadas = generarPorLotes(n, semilla, tamLote, poolHilos, [&](const LotePersonas& lote) {
+                    return escritor.escribir(lote.primeraFila, lote.personas, lote.tabla);
+                });
+                if (!escritor.terminar()) {
+                    break;
+                }
+            }
+
+            double tiempo_lotes = monitor.detener_tiempo();
+            long memoria_lotes = monitor.obtener_memoria() - memoria_inicio;
+            std::cout << "\nProcesadas " << procesadas << " personas en " << tiempo_lotes << " ms, Memoria: "
+                      << memoria_lotes << " KB (semilla " << semilla << ")";
+            if (!ruta.empty()) {
+                std::cout << " -> " << ruta;
             }
+            std::cout << "\n";
+            monitor.registrar("Generar por lotes", tiempo_lotes, memoria_lotes, procesadas);
+            monitor.mostrar_rendimiento("Generar por lotes", procesadas, tiempo_lotes);
+            break;
+        }
 
-            case 16: // Salir
-                std::cout << "Saliendo...\n";
+        case 23: { // Conjunto virtual: nada se guarda, la persona i sale de (semilla, i)
+            uint64_t n = 0, semilla = 0;
+            int accion = 0;
+            std::cout << "\nNúmero de personas del conjunto virtual: ";
+            std::cin >> n;
+            std::cout << "Semilla (0 = aleatoria): ";
+            std::cin >> semilla;
+            std::cout << "1. Análisis en una pasada  2. Persona por índice  3. Buscar por ID\nSeleccione: ";
+            std::cin >> accion;
+            if (!std::cin || n == 0 || accion < 1 || accion > 3) {
+                std::cout << "Error: Datos inválidos\n";
                 break;
+            }
+            if (semilla == 0) {
+                semilla = semillaAleatoria();
+            }
+            const ConjuntoVirtual conjunto(n, semilla);
+
+            uint64_t filas_procesadas = 0;
+            if (accion == 1) {
+                size_t tamLote = 0;
+                std::cout << "Personas por lote: ";
+                std::cin >> tamLote;
+                ResultadoAgregado resultado = conjunto.agregar(tamLote, poolHilos);
+                filas_procesadas = n;
+                std::cout << "\n--- Análisis del conjunto virtual (" << n << " filas, semilla " << semilla << ") ---\n";
+                mostrarResultadoAgregado(resultado, [&conjunto](uint64_t fila) { return conjunto.persona(fila); },
+                                         ciudadesGenerador());
+            } else if (accion == 2) {
+                uint64_t fila = 0;
+                std::cout << "Índice (0-" << n - 1 << "): ";
+                std::cin >> fila;
+                if (!std::cin || fila >= n) {
+                    std::cout << "Índice fuera de rango!\n";
+                    break;
+                }
+                conjunto.persona(fila).mostrar();
+                filas_procesadas = 1;
+            } else {
+                std::cout << "ID a buscar: ";
+                std::cin >> idBusqueda;
+                uint64_t id;
+                Persona encontrada;
+                if (convertirID(idBusqueda, id) && conjunto.buscarPorID(id, encontrada)) {
+                    encontrada.mostrar();
+                    filas_procesadas = 1;
+                } else {
+                    std::cout << "No se encontró persona con ID " << idBusqueda << "\n";
+                }
+            }
 
-            default:
+            double tiempo_virtual = monitor.detener_tiempo();
+            long memoria_virtual = monitor.obtener_memoria() - memoria_inicio;
+            monitor.registrar("Conjunto virtual", tiempo_virtual, memoria_virtual, filas_procesadas);
+            if (accion == 1) {
+                monitor.mostrar_rendimiento("Conjunto virtual", filas_procesadas, tiempo_virtual);
+            }
+            break;
+        }
 
-                std::cout << "Opción inválida!\n";
+        default:
+
+            std::cout << "Opción inválida!\n";
+    }
+    
+    // Mostrar la medición que registró la opción (las que no miden nada, como 4 y 5, no registran)
+    if (monitor.num_registros() > registros_inicio) {
+        monitor.mostrar_ultimo();
+    }
+    monitor.detener_muestreo();
+}
+
+/**
+ * Punto de entrada principal del programa.
+ * 
+ * POR QUÉ: Iniciar la aplicación y manejar el flujo principal.
+ * CÓMO: Con argumentos ejecuta un guion en modo lote; sin ellos, un bucle que muestra el
+ *       menú y procesa la opción seleccionada hasta Salir o el fin de la entrada. En ambos
+ *       modos, --asignaciones, --contadores, --muestreo y --siempre activan las mediciones
+ *       opcionales del monitor.
+ * PARA QUÉ: Ejecutar las funcionalidades del sistema.
+ */
+int main(int argc, char* argv[]) {
+    srand(time(nullptr)); // Semilla para generación aleatoria
+    
+    // Opciones de medición antes del guion: --asignaciones (reservas por operación),
+    // --contadores (contadores de rendimiento por operación), --muestreo MS (RSS en segundo plano)
+    // y --siempre N (anillo de N latencias por opción y por consulta)
+    bool contadores = false;
+    int intervaloMuestreo = 0;
+    long capacidadSiempre = 0;
+    while (argc > 1) {
+        std::string opcionMedicion = argv[1];
+        int consumidos = 1;
+        if (opcionMedicion == "--asignaciones") {
+            activarSeguimientoAsignaciones();
+        } else if (opcionMedicion == "--contadores") {
+            contadores = true;
+        } else if (opcionMedicion == "--muestreo" && argc > 2) {
+            intervaloMuestreo = std::atoi(argv[2]);
+            if (intervaloMuestreo <= 0) {
+                std::cerr << "Error: --muestreo necesita un intervalo en ms mayor que cero\n";
+                return 2;
+            }
+            consumidos = 2;
+        } else if (opcionMedicion == "--siempre" && argc > 2) {
+            capacidadSiempre = std::atol(argv[2]);
+            if (capacidadSiempre <= 0) {
+                std::cerr << "Error: --siempre necesita una capacidad mayor que cero\n";
+                return 2;
+            }
+            consumidos = 2;
+        } else {
+            break;
         }
-        
-        // Mostrar estadísticas de la operación (excepto para opciones 4,5,6)
-        if (opcion >= 0 && opcion <= 15) {
-            double tiempo = monitor.detener_tiempo();
-            long memoria = monitor.obtener_memoria() - memoria_inicio;
-            monitor.mostrar_estadistica("Opción " + std::to_string(opcion), tiempo, memoria);
+        argv[consumidos] = argv[0];
+        argv += consumidos;
+        argc -= consumidos;
+    }
+    
+    Sesion sesion(contadores);
+    sesion.monitor.activar_muestreo(intervaloMuestreo);
+    sesion.monitor.activar_siempre(static_cast<size_t>(capacidadSiempre));
+    
+    if (argc > 1) {
+        std::string guion;
+        if (!leerGuion(argc, argv, guion)) {
+            return 2;
         }
-        
+        return ejecutarLote(guion, sesion.monitor, [&sesion](int opcion) { ejecutarOpcion(sesion, opcion); });
+    }
+    
+    int opcion;
+    do {
+        mostrarMenu();
+        if (!(std::cin >> opcion)) {
+            std::cout << "\nFin de la entrada.\n";
+            break;
+        }
+        ejecutarOpcion(sesion, opcion);
     } while(opcion != 16);
     
     return 0;
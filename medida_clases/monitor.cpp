@@ -1,16 +1,109 @@
 #include "monitor.h"
-#include <unistd.h> // sysconf
-#include <cstdio>   // FILE, fscanf
+#include <unistd.h> // sysconf, pread, dup
+#include <algorithm> // std::max
+#include <atomic>   // std::atomic
+#include <cstdio>   // FILE, fgets, perror
+#include <cstdlib>  // std::atol, std::strtol
+#include <cstring>  // std::strncmp
+#include <cmath>    // std::sqrt, std::ceil
+#include <fcntl.h>  // open
+#include <iomanip>  // std::setprecision
+#include <map>      // std::map (mediciones por operación)
+
+// Monitor que reciben los tramos anidados del hilo (lo fija el tramo raíz)
+static thread_local Monitor* monitor_activo = nullptr;
+
+// Índice corto y estable de cada hilo del proceso para la traza (0, 1, 2... por orden de uso)
+static std::atomic<uint32_t> siguiente_hilo(0);
+
+static uint32_t indice_hilo() {
+    thread_local uint32_t indice = siguiente_hilo++;
+    return indice;
+}
+
+// Nombre sin la extensión .csv (para los archivos que acompañan al CSV principal)
+static std::string nombre_base(std::string nombre_archivo) {
+    if (nombre_archivo.size() > 4 && nombre_archivo.compare(nombre_archivo.size() - 4, 4, ".csv") == 0) {
+        nombre_archivo.erase(nombre_archivo.size() - 4);
+    }
+    return nombre_archivo;
+}
+
+// Pico de RSS (VmHWM de /proc/self/status) en KB, o 0 si no se puede leer
+static long leer_pico_rss() {
+    FILE* file = fopen("/proc/self/status", "r");
+    if (!file) {
+        return 0;
+    }
+    char linea[256];
+    long pico = 0;
+    while (fgets(linea, sizeof(linea), file)) {
+        if (std::strncmp(linea, "VmHWM:", 6) == 0) {
+            pico = std::atol(linea + 6);
+            break;
+        }
+    }
+    fclose(file);
+    return pico;
+}
+
+// Lleva VmHWM al RSS actual (escribiendo 5 en /proc/self/clear_refs); sin permiso, VmHWM
+// sigue siendo el pico de todo el proceso y solo cuentan las muestras
+static void reiniciar_pico_rss() {
+    FILE* file = fopen("/proc/self/clear_refs", "w");
+    if (file) {
+        fputs("5", file);
+        fclose(file);
+    }
+}
+
+/**
+ * Constructor del monitor.
+ * 
+ * POR QUÉ: Los contadores de rendimiento tienen un coste y no siempre están disponibles.
+ * CÓMO: Solo si se piden se abren; se avisa cuando el sistema no ofrece los de hardware
+ *       (contenedores y máquinas virtuales sin PMU) y quedan los de software o getrusage.
+ * PARA QUÉ: Medición opcional de IPC y fallos de caché por operación.
+ */
+Monitor::Monitor(bool contadores) : hilo_perfil(indice_hilo()) {
+    fd_statm = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    if (fd_statm < 0) {
+        perror("Error al abrir /proc/self/statm");
+    }
+    if (contadores) {
+        this->contadores = std::make_unique<ContadoresRendimiento>();
+        if (!this->contadores->hardwareDisponible()) {
+            std::cout << "Aviso: contadores de hardware no disponibles; se miden tiempo de CPU y fallos de página.\n";
+        }
+    }
+}
 
 /**
  * Inicia el cronómetro.
  * 
  * POR QUÉ: Comenzar a medir el tiempo de una operación.
- * CÓMO: Guardando el tiempo actual en 'inicio'.
- * PARA QUÉ: Poder calcular la duración después.
+ * CÓMO: Guardando el tiempo actual en 'inicio' y, con el seguimiento de asignaciones activo,
+ *       los contadores de reservas; el pico de heap se reinicia al valor actual.
+ * PARA QUÉ: Poder calcular la duración y las reservas de la operación después.
  */
 void Monitor::iniciar_tiempo() {
-    inicio = std::chrono::high_resolution_clock::now();
+    if (seguimientoAsignacionesActivo()) {
+        reiniciarPicoAsignaciones();
+        asignaciones_inicio = leerAsignaciones();
+    }
+    if (contadores) {
+        contadores->iniciar();
+    }
+    if (hilo_muestreo.joinable()) {
+        std::lock_guard<std::mutex> bloqueo(mutex_muestreo);
+        reiniciar_pico_rss();
+        pico_rss_operacion = 0;
+        suma_rss_operacion = 0;
+        muestras_operacion = 0;
+        muestreando = true;
+        cambio_muestreo.notify_one();
+    }
+    inicio = std::chrono::steady_clock::now();
 }
 
 /**
@@ -22,7 +115,7 @@ void Monitor::iniciar_tiempo() {
  * @return Tiempo en milisegundos con decimales.
  */
 double Monitor::detener_tiempo() {
-    auto fin = std::chrono::high_resolution_clock::now();
+    auto fin = std::chrono::steady_clock::now();
     std::chrono::duration<double, std::milli> duracion = fin - inicio;
     return duracion.count();
 }
@@ -30,29 +123,31 @@ double Monitor::detener_tiempo() {
 /**
  * Obtiene la memoria residente actual (RSS) del proceso en KB.
  * 
- * POR QUÉ: Medir el consumo de memoria física.
- * CÓMO: Leyendo el archivo /proc/self/statm (específico de Linux).
+ * POR QUÉ: Medir el consumo de memoria física; se llama en cada operación y en cada muestra.
+ * CÓMO: Releyendo con pread el /proc/self/statm que abrió el constructor (sin abrir, cerrar
+ *       ni fscanf por llamada) y tomando el segundo campo (páginas residentes).
+ *       pread no mueve un desplazamiento compartido, así que el muestreador puede leer a la vez.
  * PARA QUÉ: Monitorear el uso de memoria en operaciones críticas.
  * @return Memoria residente en KB, o 0 en caso de error.
  */
 long Monitor::obtener_memoria() {
-    FILE* file = fopen("/proc/self/statm", "r");
-    if (!file) {
-        perror("Error al abrir /proc/self/statm");
+    static const long page_size_kb = sysconf(_SC_PAGESIZE) / 1024;
+    if (fd_statm < 0) {
         return 0;
     }
-    
-    long size, resident, shared, text, lib, data, dt;
-    if (fscanf(file, "%ld %ld %ld %ld %ld %ld %ld", 
-              &size, &resident, &shared, &text, &lib, &data, &dt) != 7) {
-        fclose(file);
+    char bufer[128];
+    ssize_t leidos = pread(fd_statm, bufer, sizeof(bufer) - 1, 0);
+    if (leidos <= 0) {
         return 0;
     }
+    bufer[leidos] = '\0';
     
-    fclose(file);
+    // Campos: size resident shared text lib data dt
+    char* fin;
+    std::strtol(bufer, &fin, 10);
+    long resident = std::strtol(fin, nullptr, 10);
     
     // Calcular memoria en KB: resident (páginas) * tamaño_página (KB)
-    long page_size_kb = sysconf(_SC_PAGESIZE) / 1024;
     return resident * page_size_kb;
 }
 
@@ -60,11 +155,48 @@ long Monitor::obtener_memoria() {
  * Registra una operación con sus métricas de tiempo y memoria.
  * 
  * POR QUÉ: Almacenar estadísticas para análisis posterior.
- * CÓMO: Guardando un nuevo Registro en el vector y actualizando acumulados.
+ * CÓMO: Guardando un nuevo Registro en el vector y actualizando acumulados. Las reservas se
+ *       cuentan desde el último iniciar_tiempo(); el RSS de statm no ve los bloques que se
+ *       reservan y liberan dentro de la operación, estos contadores sí. Los contadores de
+ *       rendimiento se detienen aquí.
  * PARA QUÉ: Tener un histórico de rendimiento.
  */
-void Monitor::registrar(const std::string& operacion, double tiempo, long memoria) {
-    registros.push_back({operacion, tiempo, memoria});
+void Monitor::registrar(const std::string& operacion, double tiempo, long memoria, size_t filas) {
+    if (registro_suspendido) {
+        return;
+    }
+    Registro reg{};
+    reg.operacion = operacion;
+    reg.tiempo = tiempo;
+    reg.memoria = memoria;
+    reg.filas = filas;
+    if (seguimientoAsignacionesActivo()) {
+        EstadoAsignaciones actual = leerAsignaciones();
+        reg.conAsignaciones = true;
+        reg.reservas = actual.asignaciones - asignaciones_inicio.asignaciones;
+        reg.liberaciones = actual.liberaciones - asignaciones_inicio.liberaciones;
+        reg.bytesReservados = actual.bytes - asignaciones_inicio.bytes;
+        reg.picoBytes = actual.picoVivos - asignaciones_inicio.vivos;
+    }
+    if (contadores) {
+        reg.conContadores = true;
+        reg.lectura = contadores->detener();
+    }
+    if (hilo_muestreo.joinable()) {
+        // Una última muestra: las operaciones más cortas que el intervalo tienen al menos una
+        long rss = obtener_memoria();
+        long pico = leer_pico_rss();
+        std::lock_guard<std::mutex> bloqueo(mutex_muestreo);
+        if (muestreando) {
+            anotar_muestra(rss, pico);
+            muestreando = false;
+            reg.conMuestreo = true;
+            reg.picoRSS = pico_rss_operacion;
+            reg.mediaRSS = suma_rss_operacion / muestras_operacion;
+            reg.muestras = muestras_operacion;
+        }
+    }
+    registros.push_back(reg);
     total_tiempo += tiempo;
     if (memoria > max_memoria) {
         max_memoria = memoria;
@@ -84,6 +216,41 @@ void Monitor::mostrar_estadistica(const std::string& operacion, double tiempo, l
               << "Memoria: " << memoria << " KB\n";
 }
 
+/**
+ * Muestra el rendimiento de una operación en filas por segundo.
+ * 
+ * POR QUÉ: En listados y recorridos el tiempo total depende del tamaño; filas/s no.
+ * CÓMO: filas / (tiempo en segundos).
+ * PARA QUÉ: Comparar operaciones sobre conjuntos de distinto tamaño.
+ */
+void Monitor::mostrar_rendimiento(const std::string& operacion, size_t filas, double tiempo) {
+    std::cout << "\n[RENDIMIENTO] " << operacion << " - " << filas << " filas";
+    if (tiempo > 0) {
+        std::cout << ", " << static_cast<long long>(filas / (tiempo / 1000.0)) << " filas/s";
+    }
+    std::cout << "\n";
+}
+
+// IPC, tasas de fallo y eventos de software de una lectura (solo los disponibles)
+static void mostrar_contadores(const LecturaContadores& lectura) {
+    const bool* hay = lectura.disponible;
+    const uint64_t* valor = lectura.valores;
+    if (hay[CICLOS] && hay[INSTRUCCIONES] && valor[CICLOS] > 0) {
+        std::cout << ", IPC " << static_cast<double>(valor[INSTRUCCIONES]) / valor[CICLOS];
+    }
+    if (hay[REFERENCIAS_CACHE] && hay[FALLOS_CACHE] && valor[REFERENCIAS_CACHE] > 0) {
+        std::cout << ", fallos caché " << valor[FALLOS_CACHE] << " ("
+                  << 100.0 * valor[FALLOS_CACHE] / valor[REFERENCIAS_CACHE] << "%)";
+    }
+    if (hay[FALLOS_L1D]) {
+        std::cout << ", fallos L1d " << valor[FALLOS_L1D];
+    }
+    if (hay[FALLOS_SALTO]) {
+        std::cout << ", fallos salto " << valor[FALLOS_SALTO];
+    }
+    std::cout << ", CPU " << valor[TIEMPO_CPU] / 1e6 << " ms, fallos página " << valor[FALLOS_PAGINA];
+}
+
 /**
  * Muestra un resumen de todas las estadísticas registradas.
  * 
@@ -96,9 +263,71 @@ void Monitor::mostrar_resumen() {
     for (const auto& reg : registros) {
         std::cout << "\n" << reg.operacion << ": "
                   << reg.tiempo << " ms, " << reg.memoria << " KB";
+        if (reg.filas > 0 && reg.tiempo > 0) {
+            std::cout << ", " << static_cast<long long>(reg.filas / (reg.tiempo / 1000.0)) << " filas/s";
+        }
+        if (reg.conAsignaciones) {
+            std::cout << ", " << reg.reservas << " reservas / " << reg.liberaciones << " liberaciones, "
+                      << reg.bytesReservados / 1024 << " KB reservados, pico heap "
+                      << reg.picoBytes / 1024 << " KB";
+        }
+        if (reg.conMuestreo) {
+            std::cout << ", RSS pico " << reg.picoRSS << " KB, medio " << static_cast<long>(reg.mediaRSS)
+                      << " KB (" << reg.muestras << " muestras)";
+        }
+        if (reg.conContadores) {
+            mostrar_contadores(reg.lectura);
+        }
     }
     std::cout << "\nTotal tiempo: " << total_tiempo << " ms";
     std::cout << "\nMemoria máxima: " << max_memoria << " KB\n";
+    mostrar_aceleracion();
+    mostrar_repeticiones();
+    mostrar_siempre();
+    mostrar_perfil();
+}
+
+/**
+ * Registra el tiempo de una operación paralela con un número de hilos.
+ * 
+ * POR QUÉ: La aceleración solo tiene sentido comparando la misma operación con 1 y N hilos.
+ * CÓMO: Guardando (operación, hilos, tiempo) aparte de los registros normales.
+ * PARA QUÉ: Que mostrar_aceleracion calcule la aceleración por número de hilos.
+ */
+void Monitor::registrar_aceleracion(const std::string& operacion, size_t hilos, double tiempo) {
+    aceleraciones.push_back({operacion, hilos, tiempo});
+}
+
+/**
+ * Muestra la aceleración y eficiencia de cada medición paralela.
+ * 
+ * POR QUÉ: Saber cuánto rinde cada hilo adicional.
+ * CÓMO: Aceleración = tiempo con 1 hilo / tiempo con N hilos (última medición con 1 hilo
+ *       de la misma operación); eficiencia = aceleración / N.
+ * PARA QUÉ: Elegir el número de hilos adecuado para la máquina.
+ */
+void Monitor::mostrar_aceleracion() {
+    if (aceleraciones.empty()) {
+        return;
+    }
+    std::cout << "\n=== ACELERACIÓN POR NÚMERO DE HILOS ===";
+    for (size_t i = 0; i < aceleraciones.size(); ++i) {
+        const RegistroAceleracion& reg = aceleraciones[i];
+        double base = 0;
+        for (size_t j = i + 1; j-- > 0;) {
+            if (aceleraciones[j].operacion == reg.operacion && aceleraciones[j].hilos == 1) {
+                base = aceleraciones[j].tiempo;
+                break;
+            }
+        }
+        std::cout << "\n" << reg.operacion << " [" << reg.hilos << " hilos]: " << reg.tiempo << " ms";
+        if (base > 0 && reg.tiempo > 0) {
+            double aceleracion = base / reg.tiempo;
+            std::cout << ", aceleración " << aceleracion << "x, eficiencia "
+                      << 100.0 * aceleracion / reg.hilos << "%";
+        }
+    }
+    std::cout << "\n";
 }
 
 /**
@@ -115,10 +344,612 @@ void Monitor::exportar_csv(const std::string& nombre_archivo) {
         std::cerr << "Error al abrir archivo: " << nombre_archivo << std::endl;
         return;
     }
-    archivo << "Operacion,Tiempo(ms),Memoria(KB)\n";
+    // Las columnas de reservas quedan vacías si el seguimiento no estaba activo
+    // Igual con los contadores: vacíos si no se pidieron o el sistema no ofrece el evento
+    archivo << "Operacion,Tiempo(ms),Memoria(KB),Filas,Filas/s,Reservas,Liberaciones,BytesReservados,PicoHeap(bytes)";
+    for (int evento = 0; evento < NUM_EVENTOS; ++evento) {
+        archivo << "," << ContadoresRendimiento::nombreEvento(static_cast<EventoContador>(evento));
+    }
+    archivo << ",IPC,PicoRSS(KB),MediaRSS(KB),Muestras\n";
     for (const auto& reg : registros) {
-        archivo << reg.operacion << "," << reg.tiempo << "," << reg.memoria << "\n";
+        double filas_por_segundo = reg.filas > 0 && reg.tiempo > 0 ? reg.filas / (reg.tiempo / 1000.0) : 0;
+        archivo << reg.operacion << "," << reg.tiempo << "," << reg.memoria << ","
+                << reg.filas << "," << filas_por_segundo << ",";
+        if (reg.conAsignaciones) {
+            archivo << reg.reservas << "," << reg.liberaciones << "," << reg.bytesReservados << "," << reg.picoBytes;
+        } else {
+            archivo << ",,,";
+        }
+        const LecturaContadores& lectura = reg.lectura;
+        for (int evento = 0; evento < NUM_EVENTOS; ++evento) {
+            archivo << ",";
+            if (reg.conContadores && lectura.disponible[evento]) {
+                archivo << lectura.valores[evento];
+            }
+        }
+        archivo << ",";
+        if (reg.conContadores && lectura.disponible[CICLOS] && lectura.disponible[INSTRUCCIONES] &&
+            lectura.valores[CICLOS] > 0) {
+            archivo << static_cast<double>(lectura.valores[INSTRUCCIONES]) / lectura.valores[CICLOS];
+        }
+        if (reg.conMuestreo) {
+            archivo << "," << reg.picoRSS << "," << reg.mediaRSS << "," << reg.muestras;
+        } else {
+            archivo << ",,,";
+        }
+        archivo << "\n";
     }
     archivo.close();
     std::cout << "Estadísticas exportadas a " << nombre_archivo << "\n";
-}
\ No newline at end of file
+    
+    // Las repeticiones van aparte: una fila por serie, con sus estadísticas
+    std::string base = nombre_base(nombre_archivo);
+    if (!repeticiones.empty()) {
+        std::ofstream archivo_rep(base + "_repeticiones.csv");
+        if (!archivo_rep) {
+            std::cerr << "Error al abrir archivo: " << base << "_repeticiones.csv" << std::endl;
+            return;
+        }
+        archivo_rep << "Operacion,Calentamiento,Repeticiones,Min(ms),Mediana(ms),Media(ms),P95(ms),P99(ms),"
+                       "Desviacion(ms),IC95(ms)\n";
+        archivo_rep << std::fixed << std::setprecision(6);
+        for (const auto& rep : repeticiones) {
+            const EstadisticasTiempo& e = rep.estadisticas;
+            archivo_rep << rep.operacion << "," << rep.calentamiento << "," << e.muestras << "," << e.minimo << ","
+                        << e.mediana << "," << e.media << "," << e.p95 << "," << e.p99 << "," << e.desviacion
+                        << "," << e.intervalo95 << "\n";
+        }
+        std::cout << "Repeticiones exportadas a " << base << "_repeticiones.csv\n";
+    }
+    
+    // Y las mediciones del anillo, una fila por medición en orden de escritura
+    uint64_t escritas = mediciones_anillo.load(std::memory_order_acquire);
+    if (escritas > 0) {
+        std::ofstream archivo_anillo(base + "_siempre.csv");
+        if (!archivo_anillo) {
+            std::cerr << "Error al abrir archivo: " << base << "_siempre.csv" << std::endl;
+            return;
+        }
+        archivo_anillo << "Operacion,Inicio(ns),Duracion(ns),Filas,RSS(KB)\n";
+        uint64_t primera = escritas > anillo.size() ? escritas - anillo.size() : 0;
+        for (uint64_t i = primera; i < escritas; ++i) {
+            const MedicionAnillo& m = anillo[i & mascara_anillo];
+            archivo_anillo << nombres_internados[m.operacion] << "," << m.inicio << "," << m.duracion << ","
+                           << m.filas << "," << m.rss << "\n";
+        }
+        std::cout << "Mediciones siempre activas exportadas a " << base << "_siempre.csv\n";
+    }
+}
+/**
+ * Muestra las estadísticas del último registro.
+ * 
+ * POR QUÉ: El menú mostraba la estadística de cada opción volviendo a llamar a detener_tiempo,
+ *          con lo que medía dos veces (y con distinto alcance) lo que la opción ya registró.
+ * CÓMO: Reutiliza tiempo y memoria del último Registro.
+ * PARA QUÉ: Una sola medición por operación.
+ */
+void Monitor::mostrar_ultimo() {
+    if (!registros.empty()) {
+        const Registro& reg = registros.back();
+        mostrar_estadistica(reg.operacion, reg.tiempo, reg.memoria);
+    }
+}
+
+// Busca el hijo 'nombre' del tramo actual (o lo crea) y lo convierte en el tramo actual
+size_t Monitor::entrar_tramo(const char* nombre) {
+    for (size_t hijo : perfil[nodo_actual].hijos) {
+        if (perfil[hijo].nombre == nombre) {
+            nodo_actual = hijo;
+            return hijo;
+        }
+    }
+    perfil.push_back(NodoPerfil{nombre, nodo_actual, {}, 0, 0.0});
+    size_t nuevo = perfil.size() - 1;
+    perfil[nodo_actual].hijos.push_back(nuevo);
+    nodo_actual = nuevo;
+    return nuevo;
+}
+
+void Monitor::salir_tramo(size_t nodo, double tiempo) {
+    perfil[nodo].llamadas++;
+    perfil[nodo].inclusivo += tiempo;
+    nodo_actual = perfil[nodo].padre;
+}
+
+void Monitor::mostrar_nodo(size_t nodo, int nivel) const {
+    const NodoPerfil& actual = perfil[nodo];
+    if (actual.llamadas == 0) {
+        return; // Tramo todavía abierto (p. ej. la opción que muestra el resumen)
+    }
+    double hijos = 0;
+    for (size_t hijo : actual.hijos) {
+        hijos += perfil[hijo].inclusivo;
+    }
+    std::cout << "\n" << std::string(2 * nivel, ' ') << actual.nombre << " [" << actual.llamadas
+              << "x]: inclusivo " << actual.inclusivo << " ms, exclusivo " << actual.inclusivo - hijos << " ms";
+    for (size_t hijo : actual.hijos) {
+        mostrar_nodo(hijo, nivel + 1);
+    }
+}
+
+/**
+ * Muestra el árbol de tramos.
+ * 
+ * POR QUÉ: Ver qué fase de una opción es el cuello de botella.
+ * CÓMO: Recorrido en profundidad con sangría por nivel; exclusivo = inclusivo menos la suma
+ *       de los hijos (lo que el tramo hizo fuera de sus subtramos).
+ * PARA QUÉ: Resumen de estadísticas (opción 4).
+ */
+void Monitor::mostrar_perfil() const {
+    if (perfil[0].hijos.empty()) {
+        return;
+    }
+    std::cout << "\n=== PERFIL POR TRAMOS ===";
+    for (size_t hijo : perfil[0].hijos) {
+        mostrar_nodo(hijo, 0);
+    }
+    std::cout << "\n";
+}
+
+TramoPerfil::TramoPerfil(Monitor& monitor, const char* nombre) : TramoPerfil(&monitor, nombre) {}
+
+TramoPerfil::TramoPerfil(Monitor* monitor, const char* nombre)
+    : monitor(monitor), anterior(monitor_activo), raiz(true), en_arbol(false), nombre(nombre), nodo(0) {
+    monitor_activo = monitor;
+    if (monitor) {
+        en_arbol = monitor->en_hilo_perfil();
+        if (en_arbol) {
+            nodo = monitor->entrar_tramo(nombre);
+            monitor->muestrear_memoria();
+        }
+    }
+    inicio = std::chrono::steady_clock::now();
+}
+
+TramoPerfil::TramoPerfil(const char* nombre)
+    : monitor(monitor_activo), anterior(nullptr), raiz(false), en_arbol(false), nombre(nombre), nodo(0) {
+    if (monitor) {
+        en_arbol = monitor->en_hilo_perfil();
+        if (en_arbol) {
+            nodo = monitor->entrar_tramo(nombre);
+        }
+    }
+    inicio = std::chrono::steady_clock::now();
+}
+
+TramoPerfil::~TramoPerfil() {
+    if (monitor) {
+        double duracion = transcurrido();
+        monitor->registrar_evento(nombre, inicio, duracion);
+        if (en_arbol) {
+            monitor->salir_tramo(nodo, duracion);
+            if (raiz) {
+                monitor->muestrear_memoria();
+            }
+        }
+    }
+    if (raiz) {
+        monitor_activo = anterior;
+    }
+}
+
+double TramoPerfil::transcurrido() const {
+    std::chrono::duration<double, std::milli> duracion = std::chrono::steady_clock::now() - inicio;
+    return duracion.count();
+}
+
+Monitor* Monitor::activo() {
+    return monitor_activo;
+}
+
+bool Monitor::en_hilo_perfil() const {
+    return indice_hilo() == hilo_perfil;
+}
+
+// Agrega al final hasta 'maximo' (potencia de dos) elementos; luego pisa el más antiguo
+template <typename T>
+static void anotar_acotado(std::vector<T>& destino, uint64_t& total, size_t maximo, const T& elemento) {
+    if (destino.size() < maximo) {
+        destino.push_back(elemento);
+    } else {
+        destino[total & (maximo - 1)] = elemento;
+    }
+    total++;
+}
+
+void Monitor::registrar_evento(const char* nombre, std::chrono::steady_clock::time_point inicio, double duracion) {
+    std::chrono::duration<double, std::micro> desde_origen = inicio - origen;
+    std::lock_guard<std::mutex> bloqueo(mutex_traza);
+    anotar_acotado(traza, tramos_traza, MAX_TRAMOS_TRAZA,
+                   EventoTraza{nombre, indice_hilo(), desde_origen.count(), duracion * 1000.0});
+}
+
+void Monitor::muestrear_memoria() {
+    long rss = obtener_memoria();
+    std::chrono::duration<double, std::micro> instante = std::chrono::steady_clock::now() - origen;
+    std::lock_guard<std::mutex> bloqueo(mutex_traza);
+    anotar_acotado(muestras_memoria, total_muestras_memoria, MAX_MUESTRAS_MEMORIA,
+                   MuestraMemoria{instante.count(), rss, 0});
+}
+
+// Escribe un texto como cadena JSON (comillas y barras escapadas)
+static void escribir_cadena_json(std::ostream& salida, const std::string& texto) {
+    salida << '"';
+    for (char c : texto) {
+        if (c == '"' || c == '\\') {
+            salida << '\\';
+        }
+        salida << c;
+    }
+    salida << '"';
+}
+
+/**
+ * Exporta la traza en formato de eventos de Chrome (chrome://tracing, ui.perfetto.dev).
+ * 
+ * POR QUÉ: Con generación y agregación paralelas, las sumas no muestran hilos ociosos ni
+ *          esperas; una línea de tiempo sí.
+ * CÓMO: Un evento completo ("X": inicio y duración) por tramo en la pista de su hilo,
+ *       metadatos con el nombre de cada hilo y una pista de contador ("C") con el RSS.
+ *       Solo quedan los últimos MAX_TRAMOS_TRAZA tramos y MAX_MUESTRAS_MEMORIA muestras.
+ *       El hilo del monitor se llama "principal"; los demás, "trabajador N".
+ * PARA QUÉ: Ver la utilización de los hilos y los picos de memoria en el tiempo.
+ * @param nombre_archivo Nombre del archivo JSON (por defecto "traza.json")
+ */
+void Monitor::exportar_traza(const std::string& nombre_archivo) {
+    std::ofstream archivo(nombre_archivo);
+    if (!archivo) {
+        std::cerr << "Error al abrir archivo: " << nombre_archivo << std::endl;
+        return;
+    }
+    std::lock_guard<std::mutex> bloqueo(mutex_traza);
+    
+    std::vector<bool> hilos;
+    for (const EventoTraza& evento : traza) {
+        if (evento.hilo >= hilos.size()) {
+            hilos.resize(evento.hilo + 1, false);
+        }
+        hilos[evento.hilo] = true;
+    }
+    
+    archivo << std::fixed << std::setprecision(3);
+    archivo << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    archivo << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"programa\"}}";
+    for (size_t hilo = 0; hilo < hilos.size(); ++hilo) {
+        if (hilos[hilo]) {
+            std::string nombre = hilo == hilo_perfil ? "principal" : "trabajador " + std::to_string(hilo);
+            archivo << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << hilo
+                    << ",\"args\":{\"name\":";
+            escribir_cadena_json(archivo, nombre);
+            archivo << "}}";
+        }
+    }
+    // En orden de registro: del más antiguo que sigue en el anillo al más reciente
+    for (uint64_t i = tramos_traza - traza.size(); i < tramos_traza; ++i) {
+        const EventoTraza& evento = traza[i & (MAX_TRAMOS_TRAZA - 1)];
+        archivo << ",\n{\"name\":";
+        escribir_cadena_json(archivo, evento.nombre);
+        archivo << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << evento.hilo << ",\"ts\":" << evento.inicio
+                << ",\"dur\":" << evento.duracion << "}";
+    }
+    for (uint64_t i = total_muestras_memoria - muestras_memoria.size(); i < total_muestras_memoria; ++i) {
+        const MuestraMemoria& muestra = muestras_memoria[i & (MAX_MUESTRAS_MEMORIA - 1)];
+        archivo << ",\n{\"name\":\"RSS\",\"ph\":\"C\",\"pid\":1,\"ts\":" << muestra.instante
+                << ",\"args\":{\"KB\":" << muestra.rss;
+        if (muestra.pico > 0) {
+            archivo << ",\"VmHWM\":" << muestra.pico;
+        }
+        archivo << "}}";
+    }
+    archivo << "\n]}\n";
+    archivo.close();
+    std::cout << "Traza exportada a " << nombre_archivo << " (" << traza.size() << " tramos";
+    if (tramos_traza > traza.size()) {
+        std::cout << "; los " << tramos_traza - traza.size() << " más antiguos se descartaron";
+    }
+    std::cout << ")\n";
+}
+
+/**
+ * Activa el muestreador de memoria.
+ * 
+ * POR QUÉ: RSS al inicio y al final no ve lo que una operación reserva y libera antes de
+ *          terminar (mapas temporales de los rankings, copias de las versiones por valor); el
+ *          pico decide si un trabajo de millones de filas cabe en la máquina.
+ * CÓMO: Un hilo que duerme en una variable de condición mientras no hay operación y, durante
+ *       una, lee RSS (statm) y VmHWM (status) cada intervalo. VmHWM se reinicia al empezar la
+ *       operación, así que también recoge los picos que caen entre dos muestras.
+ * PARA QUÉ: Pico, media y serie temporal (pista RSS de la traza) por operación.
+ */
+void Monitor::activar_muestreo(int intervalo_ms) {
+    if (intervalo_ms <= 0 || hilo_muestreo.joinable()) {
+        return;
+    }
+    intervalo_muestreo = std::chrono::milliseconds(intervalo_ms);
+    hilo_muestreo = std::thread(&Monitor::bucle_muestreo, this);
+}
+
+void Monitor::detener_muestreo() {
+    std::lock_guard<std::mutex> bloqueo(mutex_muestreo);
+    muestreando = false;
+}
+
+Monitor::~Monitor() {
+    if (hilo_muestreo.joinable()) {
+        {
+            std::lock_guard<std::mutex> bloqueo(mutex_muestreo);
+            fin_muestreo = true;
+        }
+        cambio_muestreo.notify_one();
+        hilo_muestreo.join();
+    }
+    if (fd_statm >= 0) {
+        close(fd_statm);
+    }
+}
+
+void Monitor::anotar_muestra(long rss, long pico) {
+    long maximo = std::max(rss, pico);
+    if (maximo > pico_rss_operacion) {
+        pico_rss_operacion = maximo;
+    }
+    suma_rss_operacion += rss;
+    muestras_operacion++;
+    std::chrono::duration<double, std::micro> instante = std::chrono::steady_clock::now() - origen;
+    std::lock_guard<std::mutex> bloqueo(mutex_traza);
+    anotar_acotado(muestras_memoria, total_muestras_memoria, MAX_MUESTRAS_MEMORIA,
+                   MuestraMemoria{instante.count(), rss, pico});
+}
+
+// Espera operaciones y las muestrea hasta que el monitor se destruye
+void Monitor::bucle_muestreo() {
+    std::unique_lock<std::mutex> bloqueo(mutex_muestreo);
+    while (!fin_muestreo) {
+        if (!muestreando) {
+            cambio_muestreo.wait(bloqueo, [this] { return muestreando || fin_muestreo; });
+            continue;
+        }
+        // Las lecturas de /proc se hacen sin el mutex para no frenar iniciar_tiempo/registrar
+        bloqueo.unlock();
+        long rss = obtener_memoria();
+        long pico = leer_pico_rss();
+        bloqueo.lock();
+        if (muestreando) {
+            anotar_muestra(rss, pico);
+        }
+        cambio_muestreo.wait_for(bloqueo, intervalo_muestreo, [this] { return !muestreando || fin_muestreo; });
+    }
+}
+
+// Percentil por rango más cercano sobre datos ordenados
+static double percentil(const std::vector<double>& ordenados, double p) {
+    size_t rango = static_cast<size_t>(std::ceil(p / 100.0 * ordenados.size()));
+    return ordenados[rango > 0 ? rango - 1 : 0];
+}
+
+// t de Student bilateral al 95 % para 1..30 grados de libertad; después, la normal (1.96)
+static double tStudent95(size_t gradosLibertad) {
+    static const double tabla[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    return gradosLibertad >= 1 && gradosLibertad <= 30 ? tabla[gradosLibertad - 1] : 1.96;
+}
+
+EstadisticasTiempo calcularEstadisticas(std::vector<double> tiempos) {
+    EstadisticasTiempo e{};
+    e.muestras = tiempos.size();
+    if (tiempos.empty()) {
+        return e;
+    }
+    double suma = 0;
+    for (double t : tiempos) {
+        suma += t;
+    }
+    e.media = suma / tiempos.size();
+    double cuadrados = 0;
+    for (double t : tiempos) {
+        cuadrados += (t - e.media) * (t - e.media);
+    }
+    if (tiempos.size() > 1) {
+        e.desviacion = std::sqrt(cuadrados / (tiempos.size() - 1));
+        e.intervalo95 = tStudent95(tiempos.size() - 1) * e.desviacion / std::sqrt(static_cast<double>(tiempos.size()));
+    }
+    std::sort(tiempos.begin(), tiempos.end());
+    e.minimo = tiempos.front();
+    e.mediana = tiempos.size() % 2 ? tiempos[tiempos.size() / 2]
+                                   : (tiempos[tiempos.size() / 2 - 1] + tiempos[tiempos.size() / 2]) / 2;
+    e.p95 = percentil(tiempos, 95);
+    e.p99 = percentil(tiempos, 99);
+    return e;
+}
+
+/**
+ * Salida estándar silenciada mientras vive el objeto (RAII).
+ * 
+ * POR QUÉ: Si la operación repetida lanza una excepción, el descriptor 1 quedaría apuntando
+ *          a /dev/null y los registros suspendidos para el resto de la sesión.
+ * CÓMO: Al construirse guarda una copia del descriptor 1 y le pone /dev/null encima; al
+ *       destruirse vacía lo pendiente, restaura el original y reactiva los registros.
+ * PARA QUÉ: Que repetir() deje la sesión como estaba en cualquier caso.
+ */
+class SalidaSilenciada {
+public:
+    explicit SalidaSilenciada(bool& registroSuspendido)
+        : registroSuspendido(registroSuspendido) {
+        std::cout.flush();
+        fflush(stdout);
+        salida = dup(STDOUT_FILENO);
+        nulo = open("/dev/null", O_WRONLY);
+        if (salida >= 0 && nulo >= 0) {
+            dup2(nulo, STDOUT_FILENO);
+        }
+        registroSuspendido = true;
+    }
+    
+    ~SalidaSilenciada() {
+        registroSuspendido = false;
+        std::cout.flush();
+        fflush(stdout);
+        if (salida >= 0 && nulo >= 0) {
+            dup2(salida, STDOUT_FILENO);
+        }
+        if (salida >= 0) close(salida);
+        if (nulo >= 0) close(nulo);
+    }
+    
+    SalidaSilenciada(const SalidaSilenciada&) = delete;
+    SalidaSilenciada& operator=(const SalidaSilenciada&) = delete;
+    
+private:
+    bool& registroSuspendido;
+    int salida = -1;
+    int nulo = -1;
+};
+
+/**
+ * Implementación del modo repetición.
+ * 
+ * POR QUÉ: Una ejecución del menú da una sola muestra; las búsquedas de microsegundos quedan
+ *          dominadas por el ruido.
+ * CÓMO: La salida estándar (std::cout y escrituras directas al descriptor 1) se redirige a
+ *       /dev/null mientras se ejecuta. Cada repetición se mide con steady_clock en
+ *       nanosegundos; los registros de la operación se suspenden para que solo quede el de la
+ *       serie (la mediana, con reservas y contadores de la última repetición). SalidaSilenciada
+ *       restaura ambas cosas también si la operación lanza.
+ * PARA QUÉ: Tiempos con distribución e intervalo de confianza en lugar de una muestra.
+ */
+EstadisticasTiempo Monitor::repetir(const std::string& operacion, size_t calentamiento, size_t repeticiones,
+                                    const std::function<void()>& ejecutar) {
+    std::vector<double> tiempos;
+    tiempos.reserve(repeticiones);
+    {
+        SalidaSilenciada silencio(registro_suspendido);
+        for (size_t i = 0; i < calentamiento; ++i) {
+            ejecutar();
+        }
+        for (size_t i = 0; i < repeticiones; ++i) {
+            auto comienzo = std::chrono::steady_clock::now();
+            ejecutar();
+            auto fin = std::chrono::steady_clock::now();
+            tiempos.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(fin - comienzo).count() / 1e6);
+        }
+    }
+    
+    EstadisticasTiempo estadisticas = calcularEstadisticas(tiempos);
+    this->repeticiones.push_back({operacion, calentamiento, estadisticas});
+    registrar(operacion, estadisticas.mediana, 0);
+    return estadisticas;
+}
+
+/**
+ * Muestra las series del modo repetición.
+ * 
+ * POR QUÉ: La mediana sola no dice si la medición es estable.
+ * CÓMO: Una línea por serie con mínimo, mediana, media ± IC 95 %, p95, p99 y desviación.
+ * PARA QUÉ: Comparar operaciones con su dispersión a la vista.
+ */
+void Monitor::mostrar_repeticiones() {
+    if (repeticiones.empty()) {
+        return;
+    }
+    // Cuatro decimales: las operaciones cortas duran microsegundos
+    std::ios_base::fmtflags formato = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << "\n=== MODO REPETICIÓN ===";
+    for (const auto& rep : repeticiones) {
+        const EstadisticasTiempo& e = rep.estadisticas;
+        std::cout << "\n" << rep.operacion << " [" << rep.calentamiento << " calentamiento + " << e.muestras
+                  << " repeticiones]: min " << e.minimo << " ms, mediana " << e.mediana << " ms, media "
+                  << e.media << " ± " << e.intervalo95 << " ms, p95 " << e.p95 << " ms, p99 " << e.p99
+                  << " ms, desviación " << e.desviacion << " ms";
+    }
+    std::cout << "\n";
+    std::cout.flags(formato);
+    std::cout.precision(precision);
+}
+
+/**
+ * Activa la instrumentación siempre activa.
+ * 
+ * POR QUÉ: Medir cada consulta con registrar() costaría más que la consulta.
+ * CÓMO: Reserva el anillo una sola vez (capacidad redondeada a potencia de dos para indexar
+ *       con una máscara); anotar() solo lee el reloj, incrementa un contador atómico y copia
+ *       32 bytes.
+ * PARA QUÉ: Latencias por consulta en uso normal sin cambiar lo que se mide.
+ */
+void Monitor::activar_siempre(size_t capacidad, bool conMemoria) {
+    if (capacidad == 0 || !anillo.empty()) {
+        return;
+    }
+    size_t potencia = 1;
+    while (potencia < capacidad) {
+        potencia <<= 1;
+    }
+    anillo.resize(potencia);
+    mascara_anillo = potencia - 1;
+    memoria_anillo = conMemoria;
+}
+
+uint32_t Monitor::internar(const std::string& nombre) {
+    std::lock_guard<std::mutex> bloqueo(mutex_nombres);
+    auto it = ids_internados.find(nombre);
+    if (it != ids_internados.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(nombres_internados.size());
+    nombres_internados.push_back(nombre);
+    ids_internados.emplace(nombre, id);
+    return id;
+}
+
+// Varios hilos pueden anotar a la vez: cada uno reserva su posición con el contador atómico
+void Monitor::anotar(uint32_t operacion, int64_t inicio_ns, uint32_t filas) {
+    if (anillo.empty()) {
+        return;
+    }
+    int64_t fin = reloj_ns();
+    uint64_t posicion = mediciones_anillo.fetch_add(1, std::memory_order_relaxed);
+    MedicionAnillo& m = anillo[posicion & mascara_anillo];
+    m.operacion = operacion;
+    m.filas = filas;
+    m.inicio = inicio_ns;
+    m.duracion = fin - inicio_ns;
+    m.rss = memoria_anillo ? obtener_memoria() : 0;
+}
+
+/**
+ * Muestra las latencias de la instrumentación siempre activa.
+ * 
+ * POR QUÉ: El anillo guarda mediciones sueltas; interesa la distribución por operación.
+ * CÓMO: Agrupa las mediciones que siguen en el anillo por operación y resume cada grupo con
+ *       calcularEstadisticas (fuera del camino caliente).
+ * PARA QUÉ: Ver mediana y colas (p99) de cada consulta.
+ */
+void Monitor::mostrar_siempre() {
+    uint64_t escritas = mediciones_anillo.load(std::memory_order_acquire);
+    if (escritas == 0) {
+        return;
+    }
+    uint64_t conservadas = std::min<uint64_t>(escritas, anillo.size());
+    std::map<uint32_t, std::vector<double>> porOperacion;
+    for (uint64_t i = escritas - conservadas; i < escritas; ++i) {
+        const MedicionAnillo& m = anillo[i & mascara_anillo];
+        porOperacion[m.operacion].push_back(m.duracion / 1e3); // µs: las consultas duran ns
+    }
+    
+    std::ios_base::fmtflags formato = std::cout.flags();
+    std::streamsize precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\n=== INSTRUMENTACIÓN SIEMPRE ACTIVA (" << conservadas << " de " << escritas << " mediciones) ===";
+    for (const auto& par : porOperacion) {
+        EstadisticasTiempo e = calcularEstadisticas(par.second);
+        std::cout << "\n" << nombres_internados[par.first] << " [" << e.muestras << "x]: min " << e.minimo
+                  << " µs, mediana " << e.mediana << " µs, p95 " << e.p95 << " µs, p99 " << e.p99 << " µs";
+    }
+    std::cout << "\n";
+    std::cout.flags(formato);
+    std::cout.precision(precision);
+}
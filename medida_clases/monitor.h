@@ -6,24 +6,125 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <atomic>
+#include <unordered_map>
+#include "asignaciones.h"
+#include "contadores.h"
+
+// Estadísticas de una serie de tiempos (ms)
+struct EstadisticasTiempo {
+    size_t muestras;
+    double minimo;
+    double mediana;
+    double media;
+    double p95;
+    double p99;
+    double desviacion;  // Desviación estándar muestral
+    double intervalo95; // Semiancho del intervalo de confianza del 95 % de la media (t de Student)
+};
+
+/**
+ * Calcula las estadísticas de una serie de tiempos.
+ * 
+ * POR QUÉ: Una sola muestra mezcla caché fría, páginas nuevas y ruido del sistema.
+ * CÓMO: Mínimo, mediana, media, percentiles 95/99 por rango más cercano, desviación muestral
+ *       e intervalo de confianza de la media con t de Student (normal desde 30 muestras).
+ * PARA QUÉ: Resumir repeticiones del monitor y del benchmark con el mismo criterio.
+ */
+EstadisticasTiempo calcularEstadisticas(std::vector<double> tiempos);
 
 /**
  * Clase para monitorear el rendimiento (tiempo y memoria).
  * 
  * POR QUÉ: Cuantificar el rendimiento de las operaciones.
- * CÓMO: Midiendo tiempo con chrono y memoria con /proc/self/statm (Linux).
+ * CÓMO: Midiendo tiempo con chrono y memoria con /proc/self/statm (Linux); si el seguimiento
+ *       de asignaciones está activo, también reservas, liberaciones, bytes y pico de heap; con
+ *       contadores, ciclos, instrucciones, fallos de caché y de salto y fallos de página.
  * PARA QUÉ: Optimización y análisis de rendimiento.
  */
 class Monitor {
 public:
+    // contadores: abrir los contadores de rendimiento (perf_event_open) para cada operación.
+    // Solo miden los hilos creados después, así que el monitor debe construirse antes que el pool.
+    explicit Monitor(bool contadores = false);
+    ~Monitor();
+    bool contadores_activos() const { return contadores != nullptr; }
+    
+    // Muestrea RSS y VmHWM cada 'intervalo_ms' en un hilo aparte mientras dura cada operación
+    // (desde iniciar_tiempo hasta registrar). Se llama una vez; 0 no hace nada.
+    void activar_muestreo(int intervalo_ms);
+    
+    // Detiene el muestreo de una operación que no llegó a registrarse (p. ej. por falta de datos)
+    void detener_muestreo();
+
+    // También toma la foto inicial de las reservas y pone en marcha los contadores si están activos
     void iniciar_tiempo();
     double detener_tiempo();
     long obtener_memoria();
     
-    void registrar(const std::string& operacion, double tiempo, long memoria);
+    // filas: filas procesadas por la operación (0 si no aplica), para informar filas/s
+    void registrar(const std::string& operacion, double tiempo, long memoria, size_t filas = 0);
     void mostrar_estadistica(const std::string& operacion, double tiempo, long memoria);
+    void mostrar_rendimiento(const std::string& operacion, size_t filas, double tiempo);
+    size_t num_registros() const { return registros.size(); }
     void mostrar_resumen();
     void exportar_csv(const std::string& nombre_archivo = "estadisticas.csv");
+    
+    // Mediciones de una misma operación con distinto número de hilos
+    void registrar_aceleracion(const std::string& operacion, size_t hilos, double tiempo);
+    void mostrar_aceleracion();
+    
+    // Muestra las estadísticas del último registro (sin volver a medir)
+    void mostrar_ultimo();
+    
+    /**
+     * Modo repetición: ejecuta una operación 'calentamiento' veces sin medir y después
+     * 'repeticiones' veces midiendo cada una con steady_clock (resolución de nanosegundos).
+     * Durante las ejecuciones la salida estándar se descarta y los registros que haga la propia
+     * operación se ignoran; al final se registra la mediana con el nombre de la operación.
+     */
+    EstadisticasTiempo repetir(const std::string& operacion, size_t calentamiento, size_t repeticiones,
+                               const std::function<void()>& ejecutar);
+    void mostrar_repeticiones();
+    
+    // Perfil jerárquico alimentado por TramoPerfil
+    void mostrar_perfil() const;
+    
+    // Tramos de todos los hilos y muestras de memoria en formato de traza de Chrome/Perfetto
+    // (los más recientes: ver MAX_TRAMOS_TRAZA)
+    void exportar_traza(const std::string& nombre_archivo = "traza.json");
+    
+    // Monitor activo en el hilo actual (el de su tramo raíz), o nulo
+    static Monitor* activo();
+    
+    /**
+     * Instrumentación siempre activa: cada medición rápida (anotar, MedicionRapida) se guarda
+     * en un anillo preasignado de 'capacidad' entradas (se redondea a potencia de dos); al
+     * llenarse se sobrescriben las más antiguas. Sin llamarla, anotar no hace nada.
+     * conMemoria: leer también el RSS en cada medición (una llamada pread por medición).
+     */
+    void activar_siempre(size_t capacidad, bool conMemoria = false);
+    bool siempre_activo() const { return !anillo.empty(); }
+    
+    // Identificador estable de un nombre de operación; se llama fuera del camino caliente
+    uint32_t internar(const std::string& nombre);
+    
+    // Reloj del camino caliente: steady_clock en ns (vDSO, sin llamada al sistema en Linux)
+    static int64_t reloj_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    
+    // Camino caliente: guarda la medición [inicio_ns, ahora) de 'operacion' sin reservar memoria
+    void anotar(uint32_t operacion, int64_t inicio_ns, uint32_t filas = 0);
+    
+    // Latencias por operación del anillo
+    void mostrar_siempre();
 
 private:
     // Estructura para almacenar métricas de una operación
@@ -31,12 +132,192 @@ private:
         std::string operacion; // Nombre de la operación
         double tiempo;         // Tiempo en milisegundos
         long memoria;          // Memoria en KB
+        size_t filas;          // Filas procesadas (0 si no aplica)
+        bool conAsignaciones;  // Si se siguieron las reservas (campos siguientes)
+        uint64_t reservas;     // Llamadas a new desde iniciar_tiempo
+        uint64_t liberaciones; // Llamadas a delete desde iniciar_tiempo
+        uint64_t bytesReservados;
+        int64_t picoBytes;     // Máximo de bytes vivos por encima del inicio
+        bool conContadores;    // Si se midieron contadores de rendimiento
+        LecturaContadores lectura; // Eventos desde iniciar_tiempo (ver lectura.disponible)
+        bool conMuestreo;      // Si el muestreador de memoria estaba activo
+        long picoRSS;          // KB: máximo de las muestras y de VmHWM
+        double mediaRSS;       // KB
+        size_t muestras;
+    };
+    
+    // Tiempo de una operación paralela con un número de hilos dado
+    struct RegistroAceleracion {
+        std::string operacion;
+        size_t hilos;
+        double tiempo; // ms
+    };
+    
+    // Resultado de un modo repetición
+    struct RegistroRepeticion {
+        std::string operacion;
+        size_t calentamiento;
+        EstadisticasTiempo estadisticas;
     };
     
-    std::chrono::high_resolution_clock::time_point inicio; // Punto de inicio del cronómetro
+    std::chrono::steady_clock::time_point inicio; // Punto de inicio del cronómetro (monótono)
+    std::vector<RegistroRepeticion> repeticiones;
+    bool registro_suspendido = false; // Durante repetir(): registrar() no guarda nada
+    EstadoAsignaciones asignaciones_inicio{};               // Reservas al iniciar el cronómetro
+    std::unique_ptr<ContadoresRendimiento> contadores;      // Nulo si no se pidieron
     std::vector<Registro> registros; // Historial de registros
+    std::vector<RegistroAceleracion> aceleraciones; // Historial de barridos de hilos
+    
+    // Nodo del árbol de llamadas: un tramo con el mismo nombre bajo el mismo padre se acumula
+    struct NodoPerfil {
+        std::string nombre;
+        size_t padre;
+        std::vector<size_t> hijos;
+        uint64_t llamadas;
+        double inclusivo; // ms, incluye los tramos hijos
+    };
+    
+    std::vector<NodoPerfil> perfil{NodoPerfil{"", 0, {}, 0, 0.0}}; // perfil[0] = raíz
+    size_t nodo_actual = 0;                                           // Tramo abierto más interno
+    
+    size_t entrar_tramo(const char* nombre);
+    void salir_tramo(size_t nodo, double tiempo);
+    void mostrar_nodo(size_t nodo, int nivel) const;
+    
+    // Evento de traza: un tramo completo de un hilo; tiempos en µs desde 'origen'
+    struct EventoTraza {
+        const char* nombre; // Literal (duración estática)
+        uint32_t hilo;      // Índice del hilo (ver exportar_traza)
+        double inicio;
+        double duracion;
+    };
+    
+    // RSS en un instante (pista de contador en la traza)
+    struct MuestraMemoria {
+        double instante; // µs desde 'origen'
+        long rss;        // KB
+        long pico;       // VmHWM en KB (0 si la muestra no lo leyó)
+    };
+    
+    std::chrono::steady_clock::time_point origen = std::chrono::steady_clock::now();
+    uint32_t hilo_perfil;    // Único hilo que alimenta el árbol (el que creó el monitor)
+    std::mutex mutex_traza;  // Los tramos de los trabajadores llegan en paralelo
+    // La traza crece hasta un límite y a partir de ahí se comporta como anillo (pisa lo más
+    // antiguo), para que una sesión larga con --siempre o repetir no crezca sin cota
+    static const size_t MAX_TRAMOS_TRAZA = 1 << 18;       // 8 MB de eventos
+    static const size_t MAX_MUESTRAS_MEMORIA = 1 << 16;   // 1,5 MB de muestras
+    std::vector<EventoTraza> traza;
+    uint64_t tramos_traza = 0;                            // Total registrados (también los pisados)
+    std::vector<MuestraMemoria> muestras_memoria;
+    uint64_t total_muestras_memoria = 0;
+    
+    bool en_hilo_perfil() const;
+    void registrar_evento(const char* nombre, std::chrono::steady_clock::time_point inicio, double duracion);
+    void muestrear_memoria();
+    
+    // Muestreador de memoria en segundo plano (ver activar_muestreo)
+    std::thread hilo_muestreo;
+    std::mutex mutex_muestreo;
+    std::condition_variable cambio_muestreo;
+    std::chrono::milliseconds intervalo_muestreo{0};
+    bool muestreando = false;  // Hay una operación en curso
+    bool fin_muestreo = false; // El monitor se destruye
+    long pico_rss_operacion = 0;
+    double suma_rss_operacion = 0;
+    size_t muestras_operacion = 0;
+    
+    void bucle_muestreo();
+    void anotar_muestra(long rss, long pico); // Con mutex_muestreo tomado
+    
+    // Medición del anillo (32 bytes, sin strings)
+    struct MedicionAnillo {
+        uint32_t operacion; // Índice en nombres_internados
+        uint32_t filas;
+        int64_t inicio;     // ns de steady_clock
+        int64_t duracion;   // ns
+        long rss;           // KB (0 sin conMemoria)
+    };
+    
+    std::vector<MedicionAnillo> anillo;            // Vacío: instrumentación apagada
+    uint64_t mascara_anillo = 0;                   // capacidad - 1
+    std::atomic<uint64_t> mediciones_anillo{0};    // Total escritas (también las sobrescritas)
+    bool memoria_anillo = false;
+    std::mutex mutex_nombres;
+    std::vector<std::string> nombres_internados;
+    std::unordered_map<std::string, uint32_t> ids_internados;
+    
+    int fd_statm = -1; // /proc/self/statm abierto una vez y releído con pread
+    
+    friend class TramoPerfil;
     double total_tiempo = 0;         // Tiempo total acumulado
     long max_memoria = 0;            // Máximo de memoria utilizado
 };
 
+/**
+ * Tramo medido de una operación (RAII).
+ * 
+ * POR QUÉ: iniciar_tiempo/detener_tiempo guardan un solo instante y no se pueden anidar; una
+ *          opción completa no dice qué fase (agrupar, sumar, ordenar, mostrar) pesa más.
+ * CÓMO: El constructor abre un nodo hijo del tramo actual y el destructor suma el tiempo
+ *       transcurrido. El tramo raíz recibe el monitor y lo deja activo en su hilo; los tramos
+ *       anidados lo toman de ahí, así que las funciones de biblioteca no necesitan recibirlo.
+ *       Sin monitor activo (otros hilos, otros programas) un tramo no hace nada.
+ *       Todos los tramos quedan en la traza; el árbol solo recibe los del hilo del monitor,
+ *       y los hilos del pool aparecen en la traza por su propio tramo raíz (PoolHilos).
+ * PARA QUÉ: Un árbol de llamadas con conteos y tiempos inclusivo/exclusivo (mostrar_perfil)
+ *           y una línea de tiempo por hilo (exportar_traza).
+ */
+class TramoPerfil {
+public:
+    TramoPerfil(Monitor& monitor, const char* nombre); // Raíz: activa 'monitor' en este hilo
+    TramoPerfil(Monitor* monitor, const char* nombre); // Raíz opcional (nada si es nulo)
+    explicit TramoPerfil(const char* nombre);          // Anidado: usa el monitor activo
+    ~TramoPerfil();
+    
+    TramoPerfil(const TramoPerfil&) = delete;
+    TramoPerfil& operator=(const TramoPerfil&) = delete;
+    
+    // Milisegundos desde que se abrió el tramo
+    double transcurrido() const;
+
+private:
+    Monitor* monitor;  // Nulo si no hay monitor activo
+    Monitor* anterior; // Monitor activo antes de un tramo raíz (se restaura al cerrarlo)
+    bool raiz;
+    bool en_arbol;     // Hilo del monitor: el tramo también alimenta el árbol
+    const char* nombre;
+    size_t nodo;
+    std::chrono::steady_clock::time_point inicio;
+};
+
+/**
+ * Medición rápida de una operación (RAII) para la instrumentación siempre activa.
+ * 
+ * POR QUÉ: registrar() copia un string, lee statm y acumula varios vectores por llamada; eso
+ *          cuesta más que una consulta por ID y no sirve para medir cada consulta.
+ * CÓMO: Guarda el reloj al construirse y en el destructor escribe una entrada del anillo con
+ *       el id ya internado. Sin instrumentación activa no lee el reloj.
+ * PARA QUÉ: Latencia de cada consulta, siempre encendida, sin perturbar lo que se mide.
+ */
+class MedicionRapida {
+public:
+    MedicionRapida(Monitor& monitor, uint32_t operacion)
+        : monitor(monitor), operacion(operacion), inicio(monitor.siempre_activo() ? Monitor::reloj_ns() : 0) {}
+    ~MedicionRapida() {
+        if (inicio) {
+            monitor.anotar(operacion, inicio, filas);
+        }
+    }
+    
+    MedicionRapida(const MedicionRapida&) = delete;
+    MedicionRapida& operator=(const MedicionRapida&) = delete;
+    
+    uint32_t filas = 0; // Filas procesadas (opcional)
+
+private:
+    Monitor& monitor;
+    uint32_t operacion;
+    int64_t inicio;
+};
+
 #endif // MONITOR_H
\ No newline at end of file
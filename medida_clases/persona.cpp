@@ -1,4 +1,5 @@
 #include "persona.h"
+#include "monitor.h" // TramoPerfil
 #include <iomanip> // Para std::setprecision
 #include <algorithm>
 #include <vector>
@@ -7,7 +8,24 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <ctime>   // std::time, std::localtime
 
+INICIO_VARIANTE
+
+/**
+ * Devuelve la fecha local actual como AAAAMMDD.
+ * 
+ * POR QUÉ: La fecha de referencia por defecto debe ser "hoy" y no un año fijo.
+ * CÓMO: Usando std::time y std::localtime.
+ * PARA QUÉ: Inicializar Persona::fechaReferencia.
+ */
+static int fechaHoy() {
+    std::time_t ahora = std::time(nullptr);
+    std::tm* local = std::localtime(&ahora);
+    return Persona::empaquetarFecha(local->tm_mday, local->tm_mon + 1, local->tm_year + 1900);
+}
+
+int Persona::fechaReferencia = fechaHoy();
 
 /**
  * Implementación del constructor de Persona.
@@ -16,18 +34,42 @@
  * CÓMO: Usando la lista de inicialización y moviendo los strings para evitar copias.
  * PARA QUÉ: Eficiencia y correcta construcción del objeto.
  */
-Persona::Persona(std::string nom, std::string ape, std::string id, 
-                 std::string ciudad, std::string fecha, double ingresos, 
-                 double patri, double deud, bool declara)
-    : nombre(std::move(nom)), 
-      apellido(std::move(ape)), 
-      id(std::move(id)), 
-      ciudadNacimiento(std::move(ciudad)),
+// Constructor por defecto: persona vacía (permite reservar colecciones y llenarlas después)
+Persona::Persona()
+    : id(0), fechaEmpaquetada(0), codigoNombre(0), codigoApellidoPaterno(0), codigoApellidoMaterno(0),
+      codigoCiudad(0), declaranteRenta(false), ingresosAnuales(0), patrimonio(0), deudas(0) {}
+
+Persona::Persona(uint16_t nombre, uint16_t apellidoPaterno, uint16_t apellidoMaterno, uint64_t id,
+                 uint8_t ciudad, std::string fecha, double ingresos, double patri, double deud, bool declara)
+    : id(id), 
       fechaNacimiento(std::move(fecha)), 
+      fechaEmpaquetada(empaquetarFecha(fechaNacimiento)),
+      codigoNombre(nombre),
+      codigoApellidoPaterno(apellidoPaterno),
+      codigoApellidoMaterno(apellidoMaterno),
+      codigoCiudad(ciudad),
+      declaranteRenta(declara),
       ingresosAnuales(ingresos), 
       patrimonio(patri),
-      deudas(deud), 
-      declaranteRenta(declara) {}
+      deudas(deud) {}
+
+// Los textos se codifican aquí; el apellido compuesto se separa en el primer espacio
+Persona::Persona(const std::string& nom, const std::string& ape, uint64_t id, 
+                 const std::string& ciudad, std::string fecha, double ingresos, 
+                 double patri, double deud, bool declara)
+    : Persona(diccionarioNombres().codificar(nom),
+              diccionarioApellidos().codificar(ape.substr(0, ape.find(' '))),
+              ape.find(' ') == std::string::npos ? 0 : diccionarioApellidos().codificar(ape.substr(ape.find(' ') + 1)),
+              id,
+              static_cast<uint8_t>(diccionarioCiudades().codificar(ciudad)),
+              std::move(fecha), ingresos, patri, deud, declara) {}
+
+std::string Persona::getApellido() const {
+    if (codigoApellidoMaterno == 0) {
+        return getApellidoPaterno();
+    }
+    return getApellidoPaterno() + " " + getApellidoMaterno();
+}
 
 /**
  * Implementación de mostrar.
@@ -38,8 +80,8 @@ Persona::Persona(std::string nom, std::string ape, std::string id,
  */
 void Persona::mostrar() const {
     std::cout << "-------------------------------------\n";
-    std::cout << "[" << id << "] Nombre: " << nombre << " " << apellido << "\n";
-    std::cout << "   - Ciudad de nacimiento: " << ciudadNacimiento << "\n";
+    std::cout << "[" << id << "] Nombre: " << getNombre() << " " << getApellido() << "\n";
+    std::cout << "   - Ciudad de nacimiento: " << getCiudadNacimiento() << "\n";
     std::cout << "   - Fecha de nacimiento: " << fechaNacimiento << "\n\n";
     std::cout << std::fixed << std::setprecision(2); // Formato de números
     std::cout << "   - Ingresos anuales: $" << ingresosAnuales << "\n";
@@ -56,26 +98,49 @@ void Persona::mostrar() const {
  * PARA QUÉ: Listados rápidos y eficientes.
  */
 void Persona::mostrarResumen() const {
-    std::cout << "[" << id << "] " << nombre << " " << apellido
-              << " | " << ciudadNacimiento 
+    std::cout << "[" << id << "] " << getNombre() << " " << getApellido()
+              << " | " << getCiudadNacimiento() 
               << " | $" << std::fixed << std::setprecision(2) << ingresosAnuales
               << " | edad: " << calcularEdad();
 }
 
-//Implementacion de calcular edad
-int Persona::calcularEdad() const{
-    size_t pos = fechaNacimiento.find_last_of("/");
-    std::string año = fechaNacimiento.substr(pos + 1);
-    int añoNacimiento = std::stoi(año);
-    int añoActual = 2025; 
-    return añoActual - añoNacimiento;
+/**
+ * Implementación de empaquetarFecha.
+ * 
+ * POR QUÉ: Evitar find_last_of + substr + stoi en cada cálculo de edad.
+ * CÓMO: Acumulando los dígitos de cada campo separado por '/'.
+ * PARA QUÉ: Construir fechaEmpaquetada una sola vez por persona.
+ */
+int Persona::empaquetarFecha(const std::string& fecha) {
+    int campos[3] = {0, 0, 0}; // día, mes, año
+    int campo = 0;
+    for (char c : fecha) {
+        if (c == '/') {
+            if (++campo > 2) {
+                return 0;
+            }
+        } else if (c >= '0' && c <= '9') {
+            campos[campo] = campos[campo] * 10 + (c - '0');
+        } else {
+            return 0;
+        }
+    }
+    if (campo != 2) {
+        return 0;
+    }
+    return empaquetarFecha(campos[0], campos[1], campos[2]);
+}
+
+// Implementación de establecerFechaReferencia
+void Persona::establecerFechaReferencia(int dia, int mes, int anio) {
+    fechaReferencia = empaquetarFecha(dia, mes, anio);
 }
 
 //Implementacion de edad mas longeva del pais
-Persona Persona::edadMasLongevaPais(const std::vector<Persona> personas){
+Persona Persona::edadMasLongevaPais(const ColeccionPersonas personas){
     Persona vieja = personas[0];
     for (size_t i = 1; i < personas.size(); ++i) {
-        if (personas[i].calcularEdad() > vieja.calcularEdad()) {
+        if (personas[i].fechaEmpaquetada < vieja.fechaEmpaquetada) {
             vieja = personas[i];
         }
     }
@@ -83,11 +148,11 @@ Persona Persona::edadMasLongevaPais(const std::vector<Persona> personas){
 }
 
 //Implementacion de edad mas longeva del pais con referencias
-void Persona::edadMasLongevaPaisRef(const std::vector<Persona>& personas){
+void Persona::edadMasLongevaPaisRef(const ColeccionPersonas& personas){
     const Persona* pPersonaMasVieja = &personas[0];
 
     for (const Persona& personaActual : personas) {
-        if (personaActual.calcularEdad() > pPersonaMasVieja->calcularEdad()) {
+        if (personaActual.fechaEmpaquetada < pPersonaMasVieja->fechaEmpaquetada) {
                         pPersonaMasVieja = &personaActual;
         }
     }
@@ -97,15 +162,15 @@ void Persona::edadMasLongevaPaisRef(const std::vector<Persona>& personas){
 }
 
 //Implementacion de edad mas longeva por ciudad con valores
-std::vector<Persona> Persona::edadMasLongevaCiudad(const std::vector<Persona> personas) {
+ColeccionPersonas Persona::edadMasLongevaCiudad(const ColeccionPersonas personas) {
     std::map<std::string, Persona> ciudadMasVieja;
-    std::vector<Persona> resultado;
+    ColeccionPersonas resultado;
 
     auto gruposc = Persona::agruparCiudad(personas);
 
     for (const auto& par : gruposc) {
         const std::string& ciudad = par.first;
-        const std::vector<Persona>& personasCiudad = par.second;
+        const ColeccionPersonas& personasCiudad = par.second;
 
         if (personasCiudad.empty()) {
             continue;
@@ -114,7 +179,7 @@ std::vector<Persona> Persona::edadMasLongevaCiudad(const std::vector<Persona> pe
         Persona masLongeva = personasCiudad[0];
 
         for (size_t i = 1; i < personasCiudad.size(); ++i) {
-            if (personasCiudad[i].calcularEdad() > masLongeva.calcularEdad()) {
+            if (personasCiudad[i].fechaEmpaquetada < masLongeva.fechaEmpaquetada) {
                 masLongeva = personasCiudad[i];
             }
         }
@@ -124,14 +189,14 @@ std::vector<Persona> Persona::edadMasLongevaCiudad(const std::vector<Persona> pe
 }
 
 //Implementacion de edad mas lonegeva por ciudad utilizando referencias
-void Persona::edadMasLongevaCiudadRef(const std::vector<Persona>& personas) {
+void Persona::edadMasLongevaCiudadRef(const ColeccionPersonas& personas) {
 
-    std::map<std::string, std::vector<Persona>> ciudad;
+    GruposPersonas ciudad;
     agruparCiudadRef(personas, ciudad);
 
     for (const auto& par : ciudad) {
         const std::string& ciudad = par.first; 
-        const std::vector<Persona>& personasCiudad = par.second;
+        const ColeccionPersonas& personasCiudad = par.second;
 
         if (personasCiudad.empty()) {
             continue;
@@ -140,7 +205,7 @@ void Persona::edadMasLongevaCiudadRef(const std::vector<Persona>& personas) {
         const Persona* pMasLongeva = &personasCiudad[0];
 
         for (const Persona& personaActual : personasCiudad) {
-            if (personaActual.calcularEdad() > pMasLongeva->calcularEdad()) {
+            if (personaActual.fechaEmpaquetada < pMasLongeva->fechaEmpaquetada) {
                 pMasLongeva = &personaActual;
             }
         }
@@ -151,7 +216,7 @@ void Persona::edadMasLongevaCiudadRef(const std::vector<Persona>& personas) {
 }
 
 // Implementacion de promedio de edades por pais utilizando valores
-double Persona::promedioEdadPais(const std::vector<Persona> personas){
+double Persona::promedioEdadPais(const ColeccionPersonas personas){
     if (personas.empty()) {
         return 0.0; 
     }
@@ -165,7 +230,7 @@ double Persona::promedioEdadPais(const std::vector<Persona> personas){
 }
 
 //Implementacion de promedio de edades por pais utilizando referencias
-void Persona::promedioEdadPaisRef(const std::vector<Persona>& personas){
+void Persona::promedioEdadPaisRef(const ColeccionPersonas& personas){
     if (personas.empty()) {
         std::cout << 0.0;
     }
@@ -179,57 +244,63 @@ void Persona::promedioEdadPaisRef(const std::vector<Persona>& personas){
 
 }
     
+// Claves de los grupos de calendario, creadas una sola vez
+static const std::string& claveCalendario(char grupo) {
+    static const std::string claves[3] = {"A", "B", "C"};
+    return claves[grupo - 'A'];
+}
+
 // Agrupar por calendario - Por Valor
-std::map<std::string, std::vector<Persona>> Persona::agruparCalendario(const std::vector<Persona> personas){
-    std::map<std::string, std::vector<Persona>> calendario;
+GruposPersonas Persona::agruparCalendario(const ColeccionPersonas personas){
+    GruposPersonas calendario;
     for (const Persona& persona : personas){
-        std::string ultimosDos = (persona.id).substr((persona.id).length() - 2, 2);
-        int ultimosDosInt = std::stoi(ultimosDos);
-        if (ultimosDosInt >= 0 && ultimosDosInt <= 39){
-            calendario["A"].push_back(persona);
-        } else if (ultimosDosInt >= 40 && ultimosDosInt <= 79){
-            calendario["B"].push_back(persona);
-        } else if (ultimosDosInt >= 80 && ultimosDosInt <= 99){
-            calendario["C"].push_back(persona); 
-        }
+        calendario[claveCalendario(persona.getCalendario())].push_back(persona);
     }
     return calendario;
 }
 
 // Agrupar por calendario - Por Referencia
-void Persona::agruparCalendarioRef(const std::vector<Persona>& personas, std::map<std::string, std::vector<Persona>>& calendario){
+void Persona::agruparCalendarioRef(const ColeccionPersonas& personas, GruposPersonas& calendario){
     for (const Persona& persona : personas){
-        std::string ultimosDos = (persona.id).substr((persona.id).length() - 2, 2);
-        int ultimosDosInt = std::stoi(ultimosDos);
-        if (ultimosDosInt >= 0 && ultimosDosInt <= 39){
-            calendario["A"].push_back(persona);
-        } else if (ultimosDosInt >= 40 && ultimosDosInt <= 79){
-            calendario["B"].push_back(persona);
-        } else if (ultimosDosInt >= 80 && ultimosDosInt <= 99){
-            calendario["C"].push_back(persona); 
-        }
+        calendario[claveCalendario(persona.getCalendario())].push_back(persona);
     }
 }
 
-// Agrupar por ciudad - Por Valor
-std::map<std::string, std::vector<Persona>> Persona::agruparCiudad(const std::vector<Persona> personas){
-    std::map<std::string, std::vector<Persona>> ciudad;
+// Reparte por código de ciudad (un índice por persona) y pasa cada grupo al mapa por nombre;
+// los grupos se crean en el recurso del mapa, así pasar cada uno al mapa no copia personas
+static void repartirPorCiudad(const ColeccionPersonas& personas, GruposPersonas& ciudad) {
+    std::pmr::vector<ColeccionPersonas> porCodigo(diccionarioCiudades().tamano(), ciudad.get_allocator());
     for (const Persona& persona : personas){
-        ciudad[persona.getCiudadNacimiento()].push_back(persona);
+        porCodigo[persona.getCodigoCiudad()].push_back(persona);
     }
+    for (size_t codigo = 0; codigo < porCodigo.size(); ++codigo) {
+        if (porCodigo[codigo].empty()) {
+            continue;
+        }
+        ColeccionPersonas& grupo = ciudad[diccionarioCiudades().texto(static_cast<uint16_t>(codigo))];
+        if (grupo.empty()) {
+            grupo = std::move(porCodigo[codigo]);
+        } else {
+            grupo.insert(grupo.end(), porCodigo[codigo].begin(), porCodigo[codigo].end());
+        }
+    }
+}
+
+// Agrupar por ciudad - Por Valor
+GruposPersonas Persona::agruparCiudad(const ColeccionPersonas personas){
+    GruposPersonas ciudad;
+    repartirPorCiudad(personas, ciudad);
     return ciudad;
 }
 
 // Agrupar por ciudad - Por Referencia
-void Persona::agruparCiudadRef(const std::vector<Persona>& personas, std::map<std::string, std::vector<Persona>>& ciudad){
-    for (const Persona& persona : personas){
-        ciudad[persona.getCiudadNacimiento()].push_back(persona);
-    }
+void Persona::agruparCiudadRef(const ColeccionPersonas& personas, GruposPersonas& ciudad){
+    repartirPorCiudad(personas, ciudad);
 } 
 
 // --- FUNCIONES DE PATRIMONIO ---
 
-void Persona::mostrarMayorPatrimonioPorValor(std::vector<Persona> personas) {
+void Persona::mostrarMayorPatrimonioPorValor(ColeccionPersonas personas) {
     if (personas.empty()) {
         std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
         return;
@@ -254,77 +325,44 @@ void Persona::mostrarMayorPatrimonioPorValor(std::vector<Persona> personas) {
         mayor.mostrarResumen();
         std::cout << " Patrimonio: " << mayor.getPatrimonio() << "\n";
     } else if (subop == 2) {
-        // Mostrar la persona con mayor patrimonio de cada ciudad
-        auto gruposCiudad = Persona::agruparCiudad(personas);
+        // Mostrar la persona con mayor patrimonio de cada ciudad (vista: sin copiar personas)
+        VistaGrupos gruposCiudad = Persona::agruparCiudadVista(personas);
+        std::vector<uint32_t> masRicas = Persona::filasMayorPatrimonio(gruposCiudad, personas);
 
         std::cout << "\n--- Persona con mayor patrimonio por ciudad ---\n";
 
-        for (const auto& par : gruposCiudad) {
-            const std::string& ciudad = par.first;
-            const std::vector<Persona>& personasEnCiudad = par.second;
-
-            if (personasEnCiudad.empty()) {
-                continue;
-            }
-
-            Persona masRica = personasEnCiudad.at(0);
-            for (size_t i = 1; i < personasEnCiudad.size(); ++i) {
-                if (personasEnCiudad.at(i).getPatrimonio() > masRica.getPatrimonio()) {
-                    masRica = personasEnCiudad.at(i);
-                }
-            }
-            
-            std::cout << ciudad << ": la persona con mayor patrimonio es ";
+        for (size_t g = 0; g < gruposCiudad.numGrupos(); ++g) {
+            const Persona& masRica = personas[masRicas[g]];
+            std::cout << gruposCiudad.claves[g] << ": la persona con mayor patrimonio es ";
             masRica.mostrarResumen();
             std::cout << " con patrimonio: $" << masRica.getPatrimonio() << "\n";
         }
     } else if (subop == 3) {
         // Mostrar la persona con mayor patrimonio de cada grupo (A/B/C)
-        auto gruposPorCalendario = Persona::agruparPersonasPorCalendarioValor(personas);
+        VistaGrupos gruposPorCalendario = Persona::agruparCalendarioVista(personas);
+        std::vector<uint32_t> masRicas = Persona::filasMayorPatrimonio(gruposPorCalendario, personas);
 
         std::cout << "\n--- Persona con mayor patrimonio por grupo ---\n";
 
-        for (const auto& par : gruposPorCalendario) {
-            char grupo = par.first;
-            const std::vector<Persona>& personasEnGrupo = par.second;
-
-            if (personasEnGrupo.empty()) {
-                continue;
-            }
-
-            Persona masRica = personasEnGrupo[0];
-            for (size_t i = 1; i < personasEnGrupo.size(); ++i) {
-                if (personasEnGrupo[i].getPatrimonio() > masRica.getPatrimonio()) {
-                    masRica = personasEnGrupo[i];
-                }
-            } 
-
-            std::cout << "Grupo " << grupo << ": la persona con mayor patrimonio es ";
+        for (size_t g = 0; g < gruposPorCalendario.numGrupos(); ++g) {
+            const Persona& masRica = personas[masRicas[g]];
+            std::cout << "Grupo " << gruposPorCalendario.claves[g] << ": la persona con mayor patrimonio es ";
             masRica.mostrarResumen();
             std::cout << " con patrimonio: $" << masRica.getPatrimonio() << "\n";
         }
     }
 }
 
-std::map<char, std::vector<Persona>> Persona::agruparPersonasPorCalendarioValor(const std::vector<Persona>& personas) {
-    std::map<char, std::vector<Persona>> grupos;
+std::map<char, ColeccionPersonas> Persona::agruparPersonasPorCalendarioValor(const ColeccionPersonas& personas) {
+    std::map<char, ColeccionPersonas> grupos;
     for (const auto& persona : personas) {
-        std::string id = persona.getId();
-        std::string ultimosDos = id.substr(id.length() - 2);
-        int terminacionId = std::stoi(ultimosDos);
-        if (terminacionId <= 39) {
-            grupos['A'].push_back(persona);
-        } else if (terminacionId <= 79) {
-            grupos['B'].push_back(persona);
-        } else {
-            grupos['C'].push_back(persona);
-        }
+        grupos[persona.getCalendario()].push_back(persona);
     }
     return grupos;
 }
 
 
-void Persona::mostrarMayorPatrimonioPorReferencia(std::unique_ptr<std::vector<Persona>> personas) {
+void Persona::mostrarMayorPatrimonioPorReferencia(const std::unique_ptr<ColeccionPersonas>& personas) {
     if (!personas || personas->empty()) {
         std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
         return;
@@ -349,63 +387,50 @@ void Persona::mostrarMayorPatrimonioPorReferencia(std::unique_ptr<std::vector<Pe
         mayor.mostrarResumen();
         std::cout << " Patrimonio: " << mayor.getPatrimonio() << "\n";
     } else if (subop == 2) {
-        // Mostrar la persona con mayor patrimonio de cada ciudad
-        std::map<std::string, std::vector<Persona>> gruposCiudad;
-        Persona::agruparCiudadRef(*personas, gruposCiudad);
+        // Mostrar la persona con mayor patrimonio de cada ciudad (vista: sin copiar personas)
+        VistaGrupos gruposCiudad;
+        Persona::agruparCiudadVistaRef(*personas, gruposCiudad);
 
         std::cout << "\n--- Persona con mayor patrimonio por ciudad ---\n";
 
-        for (const auto& par : gruposCiudad) {
-            const std::string& ciudad = par.first;
-            const std::vector<Persona>& personasEnCiudad = par.second;
-
-            if (personasEnCiudad.empty()) {
-                continue;
-            }
-
-            Persona masRica = personasEnCiudad.at(0);
-            for (size_t i = 1; i < personasEnCiudad.size(); ++i) {
-                if (personasEnCiudad.at(i).getPatrimonio() > masRica.getPatrimonio()) {
-                    masRica = personasEnCiudad.at(i);
+        for (size_t g = 0; g < gruposCiudad.numGrupos(); ++g) {
+            const Persona* pMasRica = nullptr;
+            for (uint32_t fila : gruposCiudad.grupo(g)) {
+                if (!pMasRica || (*personas)[fila].getPatrimonio() > pMasRica->getPatrimonio()) {
+                    pMasRica = &(*personas)[fila];
                 }
             }
-            
-            std::cout << ciudad << ": la persona con mayor patrimonio es ";
-            masRica.mostrarResumen();
-            std::cout << " con patrimonio: $" << masRica.getPatrimonio() << "\n";
+
+            std::cout << gruposCiudad.claves[g] << ": la persona con mayor patrimonio es ";
+            pMasRica->mostrarResumen();
+            std::cout << " con patrimonio: $" << pMasRica->getPatrimonio() << "\n";
         }
     } else if (subop == 3) {
         // Mostrar la persona con mayor patrimonio de cada grupo (A/B/C)
-        std::map<char, std::vector<Persona>> gruposPorCalendario = Persona::agruparPersonasPorCalendarioValor(*personas);
+        VistaGrupos gruposPorCalendario;
+        Persona::agruparCalendarioVistaRef(*personas, gruposPorCalendario);
 
         std::cout << "\n--- Persona con mayor patrimonio por grupo ---\n";
 
-        for (const auto& par : gruposPorCalendario) {
-            char grupo = par.first;
-            const std::vector<Persona>& personasEnGrupo = par.second;
-
-            if (personasEnGrupo.empty()) {
-                continue;
-            }
-
-            Persona masRica = personasEnGrupo[0];
-            for (size_t i = 1; i < personasEnGrupo.size(); ++i) {
-                if (personasEnGrupo[i].getPatrimonio() > masRica.getPatrimonio()) {
-                    masRica = personasEnGrupo[i];
+        for (size_t g = 0; g < gruposPorCalendario.numGrupos(); ++g) {
+            const Persona* pMasRica = nullptr;
+            for (uint32_t fila : gruposPorCalendario.grupo(g)) {
+                if (!pMasRica || (*personas)[fila].getPatrimonio() > pMasRica->getPatrimonio()) {
+                    pMasRica = &(*personas)[fila];
                 }
-            } 
+            }
 
-            std::cout << "Grupo " << grupo << ": la persona con mayor patrimonio es ";
-            masRica.mostrarResumen();
-            std::cout << " con patrimonio: $" << masRica.getPatrimonio() << "\n";
+            std::cout << "Grupo " << gruposPorCalendario.claves[g] << ": la persona con mayor patrimonio es ";
+            pMasRica->mostrarResumen();
+            std::cout << " con patrimonio: $" << pMasRica->getPatrimonio() << "\n";
         }
     }
 }
 
 
 // Declarantes de renta - Por Valor
-std::map<std::string, std::vector<Persona>> Persona::declarantesRenta(std::map<std::string, std::vector<Persona>> personas){
-    std::map<std::string, std::vector<Persona>> declarantes;
+GruposPersonas Persona::declarantesRenta(GruposPersonas personas){
+    GruposPersonas declarantes;
     for (const auto& grupo : personas){
         for (const Persona& persona : grupo.second){
             if (persona.getDeclaranteRenta()){
@@ -417,7 +442,7 @@ std::map<std::string, std::vector<Persona>> Persona::declarantesRenta(std::map<s
 }
 
 //Declarantes de renta - Por Referencia
-void Persona::declarantesRentaRef(const std::map<std::string, std::vector<Persona>>& personas, std::map<std::string, std::vector<Persona>>& declarantes){
+void Persona::declarantesRentaRef(const GruposPersonas& personas, GruposPersonas& declarantes){
     for (const auto& grupo : personas){
         for (const Persona& persona : grupo.second){
             if (persona.getDeclaranteRenta()){
@@ -428,12 +453,12 @@ void Persona::declarantesRentaRef(const std::map<std::string, std::vector<Person
 }
 
 // Ranking de riqueza por agrupación - Por valor
-std::vector<std::pair<std::string, double>> Persona::rankingRiqueza(const std::map<std::string, std::vector<Persona>> calendario) {
+std::vector<std::pair<std::string, double>> Persona::rankingRiqueza(const GruposPersonas calendario) {
     // Calculamos la suma de ingresos para cada grupo 
     std::map<std::string, double> sumasPorCalendario;
     for (const auto& par : calendario) { 
         const std::string grupo = par.first;
-        const std::vector<Persona> personasDelGrupo = par.second;
+        const ColeccionPersonas personasDelGrupo = par.second;
         double sumaTotalGrupo = 0.0;
         for (const Persona& persona : personasDelGrupo) { 
             sumaTotalGrupo += persona.getIngresosAnuales();
@@ -450,12 +475,12 @@ std::vector<std::pair<std::string, double>> Persona::rankingRiqueza(const std::m
 }
 
 // Ranking de riqueza por agrupación - Por referencia
-void Persona::rankingRiquezaRef(const std::map<std::string, std::vector<Persona>>& calendario, std::vector<std::pair<std::string, double>>& ranking) {
+void Persona::rankingRiquezaRef(const GruposPersonas& calendario, std::vector<std::pair<std::string, double>>& ranking) {
     // Calculamos la suma de ingresos para cada grupo 
     std::map<std::string, double> sumasPorCalendario;
     for (const auto& par : calendario) { 
         const std::string grupo = par.first;
-        const std::vector<Persona> personasDelGrupo = par.second;
+        const ColeccionPersonas personasDelGrupo = par.second;
         double sumaTotalGrupo = 0.0;
         for (const Persona& persona : personasDelGrupo) { 
             sumaTotalGrupo += persona.getIngresosAnuales();
@@ -471,12 +496,12 @@ void Persona::rankingRiquezaRef(const std::map<std::string, std::vector<Persona>
 }
 
 // Ranking de riqueza por ciudad - Por Valor
-std::vector<std::pair<std::string, double>> Persona::rankingRiquezaCiudad(const std::map<std::string, std::vector<Persona>> ciudad) {
+std::vector<std::pair<std::string, double>> Persona::rankingRiquezaCiudad(const GruposPersonas ciudad) {
     // Calculamos la suma de ingresos para cada grupo 
     std::map<std::string, double> sumasPorCiudad;
     for (const auto& par : ciudad) { 
         const std::string grupo = par.first;
-        const std::vector<Persona> personasDelGrupo = par.second;
+        const ColeccionPersonas personasDelGrupo = par.second;
         double sumaTotalGrupo = 0.0;
         for (const Persona& persona : personasDelGrupo) { 
             sumaTotalGrupo += persona.getIngresosAnuales();
@@ -493,12 +518,12 @@ std::vector<std::pair<std::string, double>> Persona::rankingRiquezaCiudad(const
 }
 
 // Ranking de riqueza por ciudad - Por Referencia
-void Persona::rankingRiquezaCiudadRef(const std::map<std::string, std::vector<Persona>>& ciudad, std::vector<std::pair<std::string, double>>& ranking) {
+void Persona::rankingRiquezaCiudadRef(const GruposPersonas& ciudad, std::vector<std::pair<std::string, double>>& ranking) {
     // Calculamos la suma de ingresos para cada grupo 
     std::map<std::string, double> sumasPorCiudad;
     for (const auto& par : ciudad) { 
         const std::string grupo = par.first;
-        const std::vector<Persona> personasDelGrupo = par.second;
+        const ColeccionPersonas personasDelGrupo = par.second;
         double sumaTotalGrupo = 0.0;
         for (const Persona& persona : personasDelGrupo) { 
             sumaTotalGrupo += persona.getIngresosAnuales();
@@ -511,4 +536,127 @@ void Persona::rankingRiquezaCiudadRef(const std::map<std::string, std::vector<Pe
     std::sort(ranking.begin(), ranking.end(), [](const std::pair<std::string, double> a, const std::pair<std::string, double> b) {
         return a.second > b.second; 
     });
-}
\ No newline at end of file
+}
+
+// --- VISTAS DE AGRUPACIÓN ---
+
+/**
+ * Implementación de agruparCiudadVistaRef.
+ * 
+ * POR QUÉ: Agrupar por ciudad sin copiar personas.
+ * CÓMO: El código de ciudad de cada persona ya es el código de grupo; las claves son los
+ *       textos del diccionario (construirVista descarta las ciudades sin personas).
+ * PARA QUÉ: Opciones de ranking y patrimonio por ciudad con memoria constante por persona.
+ */
+void Persona::agruparCiudadVistaRef(const ColeccionPersonas& personas, VistaGrupos& vista) {
+    TramoPerfil tramo("agrupar");
+    std::vector<std::string> claves(diccionarioCiudades().tamano());
+    for (size_t codigo = 0; codigo < claves.size(); ++codigo) {
+        claves[codigo] = diccionarioCiudades().texto(static_cast<uint16_t>(codigo));
+    }
+    std::vector<uint32_t> codigos(personas.size());
+    for (size_t i = 0; i < personas.size(); ++i) {
+        codigos[i] = personas[i].codigoCiudad;
+    }
+    construirVista(claves, codigos, vista);
+}
+
+VistaGrupos Persona::agruparCiudadVista(const ColeccionPersonas& personas) {
+    VistaGrupos vista;
+    agruparCiudadVistaRef(personas, vista);
+    return vista;
+}
+
+// Agrupar por calendario con vista: el código sale de la tabla de terminaciones del ID
+void Persona::agruparCalendarioVistaRef(const ColeccionPersonas& personas, VistaGrupos& vista) {
+    TramoPerfil tramo("agrupar");
+    static const std::vector<std::string> claves = {"A", "B", "C"};
+    std::vector<uint32_t> codigos(personas.size());
+    for (size_t i = 0; i < personas.size(); ++i) {
+        codigos[i] = static_cast<uint32_t>(personas[i].getCalendario() - 'A');
+    }
+    construirVista(claves, codigos, vista);
+}
+
+VistaGrupos Persona::agruparCalendarioVista(const ColeccionPersonas& personas) {
+    VistaGrupos vista;
+    agruparCalendarioVistaRef(personas, vista);
+    return vista;
+}
+
+/**
+ * Implementación de declarantesRentaVistaRef.
+ * 
+ * POR QUÉ: Filtrar declarantes sin volver a copiar las personas de cada grupo.
+ * CÓMO: Recorre las filas de cada grupo y conserva solo las de declarantes; la vista
+ *       resultante mantiene las mismas claves (excepto grupos que queden vacíos).
+ * PARA QUÉ: Opciones 8 y 9 del menú.
+ */
+void Persona::declarantesRentaVistaRef(const VistaGrupos& grupos, const ColeccionPersonas& personas, VistaGrupos& declarantes) {
+    TramoPerfil tramo("filtrar declarantes");
+    declarantes.limpiar();
+    declarantes.inicios.push_back(0);
+    for (size_t g = 0; g < grupos.numGrupos(); ++g) {
+        size_t antes = declarantes.filas.size();
+        for (uint32_t fila : grupos.grupo(g)) {
+            if (personas[fila].declaranteRenta) {
+                declarantes.filas.push_back(fila);
+            }
+        }
+        if (declarantes.filas.size() > antes) {
+            declarantes.claves.push_back(grupos.claves[g]);
+            declarantes.inicios.push_back(static_cast<uint32_t>(declarantes.filas.size()));
+        }
+    }
+}
+
+VistaGrupos Persona::declarantesRentaVista(const VistaGrupos& grupos, const ColeccionPersonas& personas) {
+    VistaGrupos declarantes;
+    declarantesRentaVistaRef(grupos, personas, declarantes);
+    return declarantes;
+}
+
+// Ranking sobre una vista: suma los ingresos de las filas de cada grupo y ordena descendente
+void Persona::rankingRiquezaVistaRef(const VistaGrupos& grupos, const ColeccionPersonas& personas, std::vector<std::pair<std::string, double>>& ranking) {
+    ranking.clear();
+    ranking.reserve(grupos.numGrupos());
+    {
+        TramoPerfil tramo("sumar");
+        for (size_t g = 0; g < grupos.numGrupos(); ++g) {
+            double sumaTotalGrupo = 0.0;
+            for (uint32_t fila : grupos.grupo(g)) {
+                sumaTotalGrupo += personas[fila].ingresosAnuales;
+            }
+            ranking.emplace_back(grupos.claves[g], sumaTotalGrupo);
+        }
+    }
+    TramoPerfil tramo("ordenar");
+    std::sort(ranking.begin(), ranking.end(), [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) {
+        return a.second > b.second;
+    });
+}
+
+std::vector<std::pair<std::string, double>> Persona::rankingRiquezaVista(const VistaGrupos& grupos, const ColeccionPersonas& personas) {
+    std::vector<std::pair<std::string, double>> ranking;
+    rankingRiquezaVistaRef(grupos, personas, ranking);
+    return ranking;
+}
+
+// Mayor patrimonio de cada grupo: la primera fila gana en empates, como en las versiones con copias
+std::vector<uint32_t> Persona::filasMayorPatrimonio(const VistaGrupos& grupos, const ColeccionPersonas& personas) {
+    std::vector<uint32_t> resultado;
+    resultado.reserve(grupos.numGrupos());
+    for (size_t g = 0; g < grupos.numGrupos(); ++g) {
+        VistaGrupos::RangoFilas filas = grupos.grupo(g);
+        uint32_t mejor = *filas.begin();
+        for (uint32_t fila : filas) {
+            if (personas[fila].patrimonio > personas[mejor].patrimonio) {
+                mejor = fila;
+            }
+        }
+        resultado.push_back(mejor);
+    }
+    return resultado;
+}
+
+FIN_VARIANTE
@@ -2,30 +2,76 @@
 #define PERSONA_H
 
 #include <map>
+#include <memory_resource>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <iomanip>
 #include <memory>
+#include <cstdint>
+#include "grupos.h"
+#include "diccionario.h"
+#include "espacio_variante.h"
+
+INICIO_VARIANTE
+
+/**
+ * Tabla de clasificación de calendario (A/B/C) por terminación del ID.
+ * 
+ * POR QUÉ: Clasificar millones de IDs sin substr ni stoi.
+ * CÓMO: Arreglo de 100 letras calculado en tiempo de compilación: 00-39 A, 40-79 B, 80-99 C.
+ * PARA QUÉ: Que el grupo de un ID sea TABLA_CALENDARIO.grupo[id % 100].
+ */
+struct TablaCalendario {
+    char grupo[100];
+};
+
+constexpr TablaCalendario construirTablaCalendario() {
+    TablaCalendario tabla{};
+    for (int i = 0; i < 100; ++i) {
+        tabla.grupo[i] = i <= 39 ? 'A' : (i <= 79 ? 'B' : 'C');
+    }
+    return tabla;
+}
+
+constexpr TablaCalendario TABLA_CALENDARIO = construirTablaCalendario();
+
+class Persona;
+
+/**
+ * Colección de personas y agrupación por clave sobre un recurso de memoria (std::pmr).
+ * 
+ * POR QUÉ: Regenerar el conjunto y agrupar piden y devuelven memoria bloque a bloque.
+ * CÓMO: Contenedores pmr: sin recurso usan el heap como std::vector/std::map; con una Arena
+ *       (arena.h) toda su memoria sale de ella y se devuelve de una vez al reiniciarla.
+ *       GruposPersonas pasa su recurso a los vectores de cada grupo.
+ * PARA QUÉ: Que la sesión decida dónde viven los datos sin cambiar las funciones de Persona.
+ */
+using ColeccionPersonas = std::pmr::vector<Persona>;
+using GruposPersonas = std::pmr::map<std::string, ColeccionPersonas>;
 
 /**
  * Clase que representa una persona con datos personales y financieros.
  * 
  * POR QUÉ: Para modelar una entidad persona con atributos relevantes para el sistema.
  * CÓMO: Mediante una clase con atributos privados y métodos públicos de acceso y visualización.
+ *       Nombre, apellidos y ciudad se guardan como códigos de los diccionarios compartidos
+ *       (diccionario.h); los getters devuelven el texto del diccionario.
  * PARA QUÉ: Centralizar y encapsular la información de una persona, garantizando integridad de datos.
  */
 class Persona {
 private:
-    std::string nombre;           // Nombre de pila
-    std::string apellido;         // Apellidos
-    std::string id;               // Identificador único (cédula)
-    std::string ciudadNacimiento; // Ciudad de nacimiento
-    std::string fechaNacimiento;  // Fecha de nacimiento en formato DD/MM/AAAA
-    double ingresosAnuales;       // Ingresos anuales en pesos colombianos
-    double patrimonio;            // Patrimonio total (activos)
-    double deudas;                // Deudas totales (pasivos)
-    bool declaranteRenta;         // Si es declarante de renta
+    uint64_t id;                    // Identificador único (cédula), numérico
+    std::string fechaNacimiento;    // Fecha de nacimiento en formato DD/MM/AAAA
+    int fechaEmpaquetada;           // Misma fecha como entero AAAAMMDD (precalculada)
+    uint16_t codigoNombre;          // Nombre de pila (diccionarioNombres)
+    uint16_t codigoApellidoPaterno; // Primer apellido (diccionarioApellidos)
+    uint16_t codigoApellidoMaterno; // Segundo apellido (0 = ninguno)
+    uint8_t codigoCiudad;           // Ciudad de nacimiento (diccionarioCiudades)
+    bool declaranteRenta;           // Si es declarante de renta
+    double ingresosAnuales;         // Ingresos anuales en pesos colombianos
+    double patrimonio;              // Patrimonio total (activos)
+    double deudas;                  // Deudas totales (pasivos)
 
 public:
     /**
@@ -37,20 +83,38 @@ public:
      */
     Persona(); // Constructor por defecto
 
-    Persona(std::string nom, std::string ape, std::string id, 
-            std::string ciudad, std::string fecha, double ingresos, 
+    // Desde texto: codifica nombre y ciudad; 'ape' se separa en el primer espacio en
+    // apellido paterno y materno
+    Persona(const std::string& nom, const std::string& ape, uint64_t id, 
+            const std::string& ciudad, std::string fecha, double ingresos, 
             double patri, double deud, bool declara);
     
+    // Desde códigos ya obtenidos de los diccionarios (sin búsquedas ni bloqueos)
+    Persona(uint16_t nombre, uint16_t apellidoPaterno, uint16_t apellidoMaterno, uint64_t id,
+            uint8_t ciudad, std::string fecha, double ingresos, double patri, double deud, bool declara);
+    
     // Métodos de acceso (getters) - Implementados inline para eficiencia
-    std::string getNombre() const { return nombre; }
-    std::string getApellido() const { return apellido; }
-    std::string getId() const { return id; }
-    std::string getCiudadNacimiento() const { return ciudadNacimiento; }
-    std::string getFechaNacimiento() const { return fechaNacimiento; }
+    // Los textos se devuelven por referencia al diccionario: leerlos no copia ni reserva memoria
+    const std::string& getNombre() const { return diccionarioNombres().texto(codigoNombre); }
+    const std::string& getApellidoPaterno() const { return diccionarioApellidos().texto(codigoApellidoPaterno); }
+    const std::string& getApellidoMaterno() const { return diccionarioApellidos().texto(codigoApellidoMaterno); }
+    std::string getApellido() const; // "Paterno Materno" (construye el texto: solo para mostrar)
+    uint64_t getId() const { return id; }
+    const std::string& getCiudadNacimiento() const { return diccionarioCiudades().texto(codigoCiudad); }
+    uint8_t getCodigoCiudad() const { return codigoCiudad; }
+    uint16_t getCodigoNombre() const { return codigoNombre; }
+    uint16_t getCodigoApellidoPaterno() const { return codigoApellidoPaterno; }
+    uint16_t getCodigoApellidoMaterno() const { return codigoApellidoMaterno; }
+    const std::string& getFechaNacimiento() const { return fechaNacimiento; }
     double getIngresosAnuales() const { return ingresosAnuales; }
     double getPatrimonio() const { return patrimonio; }
     double getDeudas() const { return deudas; }
     bool getDeclaranteRenta() const { return declaranteRenta; }
+    int getFechaEmpaquetada() const { return fechaEmpaquetada; }
+
+    // Grupo de calendario (A/B/C) según los dos últimos dígitos del ID
+    static char calendarioDeId(uint64_t id) { return TABLA_CALENDARIO.grupo[id % 100]; }
+    char getCalendario() const { return calendarioDeId(id); }
 
     /**
      * Muestra toda la información de la persona de forma detallada.
@@ -70,67 +134,125 @@ public:
      */
     void mostrarResumen() const;
 
-    // Calcula la edad de una persona
-    int calcularEdad() const;
+    /**
+     * Calcula la edad cumplida de la persona en la fecha de referencia.
+     * 
+     * POR QUÉ: Se llama millones de veces en los recorridos de edad.
+     * CÓMO: Con fechas AAAAMMDD, (referencia - nacimiento) / 10000 da los años cumplidos
+     *       exactos al día, sin interpretar strings.
+     * PARA QUÉ: Edad exacta y sin asignaciones de memoria.
+     */
+    int calcularEdad() const { return (fechaReferencia - fechaEmpaquetada) / 10000; }
+
+    /**
+     * Convierte una fecha "D/M/AAAA" en el entero AAAAMMDD.
+     * 
+     * POR QUÉ: Interpretar la fecha una sola vez (en el constructor) y no en cada cálculo.
+     * CÓMO: Recorriendo los dígitos sin crear substrings.
+     * PARA QUÉ: Fechas comparables con < y edades calculables con aritmética.
+     * @return Fecha empaquetada, o 0 si el formato no es válido.
+     */
+    static int empaquetarFecha(const std::string& fecha);
+
+    // Empaqueta una fecha ya separada en día, mes y año
+    static int empaquetarFecha(int dia, int mes, int anio) { return anio * 10000 + mes * 100 + dia; }
+
+    // Fecha de referencia (AAAAMMDD) para calcular edades; por defecto, la fecha de hoy
+    static void establecerFechaReferencia(int dia, int mes, int anio);
+    static int getFechaReferencia() { return fechaReferencia; }
 
     // Muestra la edad de la persona mas longeva por pais utilizando valores
-    static Persona edadMasLongevaPais(const std::vector<Persona> personas);
+    static Persona edadMasLongevaPais(const ColeccionPersonas personas);
 
     // Muesta la edad de la persona mas longeva por pais utilizando apuntadores
-    static void edadMasLongevaPaisRef(const std::vector<Persona>& personas);
+    static void edadMasLongevaPaisRef(const ColeccionPersonas& personas);
 
     //Muestra el promedio de edades por pais utilizando valores
-    static double promedioEdadPais(const std::vector<Persona> personas);
+    static double promedioEdadPais(const ColeccionPersonas personas);
 
     //Muestra el promedio de edades por pais utilizando apuntadores
-    static void promedioEdadPaisRef(const std::vector<Persona>& personas);
+    static void promedioEdadPaisRef(const ColeccionPersonas& personas);
 
     // Agrupa las personas por calendario - Valor
-    static std::map<std::string, std::vector<Persona>> agruparCalendario(const std::vector<Persona> personas);
+    static GruposPersonas agruparCalendario(const ColeccionPersonas personas);
 
     // Agrupa las personas por calendario - Referencia
-    static void agruparCalendarioRef(const std::vector<Persona>& personas, std::map<std::string, std::vector<Persona>>& calendario);
+    static void agruparCalendarioRef(const ColeccionPersonas& personas, GruposPersonas& calendario);
 
     // Agrupar personas por ciudad - Valor
-    static std::map<std::string, std::vector<Persona>> agruparCiudad(const std::vector<Persona> personas);
+    static GruposPersonas agruparCiudad(const ColeccionPersonas personas);
 
     // Agrupar personas por ciudad - Referencia
-    static void agruparCiudadRef(const std::vector<Persona>& personas, std::map<std::string, std::vector<Persona>>& ciudad);
+    static void agruparCiudadRef(const ColeccionPersonas& personas, GruposPersonas& ciudad);
 
     // Declarantes de renta - Valor
-    static std::map<std::string, std::vector<Persona>> declarantesRenta(std::map<std::string, std::vector<Persona>> personas);
+    static GruposPersonas declarantesRenta(GruposPersonas personas);
 
     //Declarantes de renta - Referencia
-    static void declarantesRentaRef(const std::map<std::string, std::vector<Persona>>& personas, std::map<std::string, std::vector<Persona>>& declarantes);
+    static void declarantesRentaRef(const GruposPersonas& personas, GruposPersonas& declarantes);
 
     // Ranking de riqueza por agrupación - Valor
-    static std::vector<std::pair<std::string, double>> rankingRiqueza(const std::map<std::string, std::vector<Persona>> calendario);
+    static std::vector<std::pair<std::string, double>> rankingRiqueza(const GruposPersonas calendario);
 
     // Ranking de riqueza por agrupación - Referencia
-    static void rankingRiquezaRef(const std::map<std::string, std::vector<Persona>>& calendario, std::vector<std::pair<std::string, double>>& ranking);
+    static void rankingRiquezaRef(const GruposPersonas& calendario, std::vector<std::pair<std::string, double>>& ranking);
 
     //Ranking de riqueza por ciudad - Valor
-    static std::vector<std::pair<std::string, double>> rankingRiquezaCiudad(const std::map<std::string, std::vector<Persona>> ciudad); 
+    static std::vector<std::pair<std::string, double>> rankingRiquezaCiudad(const GruposPersonas ciudad); 
 
     //Ranking de riqueza por ciudad - Referencia
-    static void rankingRiquezaCiudadRef(const std::map<std::string, std::vector<Persona>>& ciudad, std::vector<std::pair<std::string, double>>& ranking);
+    static void rankingRiquezaCiudadRef(const GruposPersonas& ciudad, std::vector<std::pair<std::string, double>>& ranking);
 
     // Muestra la edad de la persona mas longeva por ciudad utilizando valores
-    static std::vector<Persona> edadMasLongevaCiudad(const std::vector<Persona> personas);
+    static ColeccionPersonas edadMasLongevaCiudad(const ColeccionPersonas personas);
 
     // Muestra la edad de la persona mas longeva por ciudad utilizando apuntadores
-    static void edadMasLongevaCiudadRef(const std::vector<Persona>& personas);
+    static void edadMasLongevaCiudadRef(const ColeccionPersonas& personas);
     // --- FUNCIONES DE PATRIMONIO ---
     
     //muestra el mayor patrimonio por valor
-    static void mostrarMayorPatrimonioPorValor(std::vector<Persona> personas);
+    static void mostrarMayorPatrimonioPorValor(ColeccionPersonas personas);
 
     //muestra el mayor patrimonio por referencia
-    static void mostrarMayorPatrimonioPorReferencia(std::unique_ptr<std::vector<Persona>> personas);
+    static void mostrarMayorPatrimonioPorReferencia(const std::unique_ptr<ColeccionPersonas>& personas);
 
      // Agrupar personas por calendario (A/B/C) - Valor
-    static std::map<char, std::vector<Persona>> agruparPersonasPorCalendarioValor(const std::vector<Persona>& personas);
+    static std::map<char, ColeccionPersonas> agruparPersonasPorCalendarioValor(const ColeccionPersonas& personas);
+
+    // --- VISTAS DE AGRUPACIÓN (sin copiar personas) ---
+    // Las vistas guardan índices de fila; los datos se leen siempre de 'personas'.
+
+    // Agrupa por ciudad - devuelve la vista
+    static VistaGrupos agruparCiudadVista(const ColeccionPersonas& personas);
+
+    // Agrupa por ciudad - llena la vista recibida
+    static void agruparCiudadVistaRef(const ColeccionPersonas& personas, VistaGrupos& vista);
 
+    // Agrupa por calendario (A/B/C) - devuelve la vista
+    static VistaGrupos agruparCalendarioVista(const ColeccionPersonas& personas);
+
+    // Agrupa por calendario (A/B/C) - llena la vista recibida
+    static void agruparCalendarioVistaRef(const ColeccionPersonas& personas, VistaGrupos& vista);
+
+    // Declarantes de renta de cada grupo - devuelve la vista filtrada
+    static VistaGrupos declarantesRentaVista(const VistaGrupos& grupos, const ColeccionPersonas& personas);
+
+    // Declarantes de renta de cada grupo - llena la vista recibida
+    static void declarantesRentaVistaRef(const VistaGrupos& grupos, const ColeccionPersonas& personas, VistaGrupos& declarantes);
+
+    // Ranking de suma de ingresos de cada grupo de la vista - devuelve el ranking
+    static std::vector<std::pair<std::string, double>> rankingRiquezaVista(const VistaGrupos& grupos, const ColeccionPersonas& personas);
+
+    // Ranking de suma de ingresos de cada grupo de la vista - llena el ranking recibido
+    static void rankingRiquezaVistaRef(const VistaGrupos& grupos, const ColeccionPersonas& personas, std::vector<std::pair<std::string, double>>& ranking);
+
+    // Fila con mayor patrimonio de cada grupo de la vista (en el orden de los grupos)
+    static std::vector<uint32_t> filasMayorPatrimonio(const VistaGrupos& grupos, const ColeccionPersonas& personas);
+
+private:
+    static int fechaReferencia; // Fecha AAAAMMDD contra la que se calculan las edades
 };
 
+FIN_VARIANTE
+
 #endif // PERSONA_H
\ No newline at end of file
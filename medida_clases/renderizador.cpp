@@ -0,0 +1,127 @@
+#include "renderizador.h"
+#include <algorithm> // std::min
+#include <cerrno>    // errno, EINTR
+#include <charconv>  // std::to_chars
+#include <cstdio>    // std::fflush
+#include <cstring>   // std::memcpy, std::strlen
+#include <unistd.h>  // write
+
+// Máximo que ocupan los campos numéricos de una fila (ID, índice, ingresos, edad y separadores)
+static const size_t MAX_NUMEROS_FILA = 128;
+
+Renderizador::Renderizador(int descriptor, size_t capacidad)
+    : descriptor(descriptor), bufer(std::max(capacidad, MAX_NUMEROS_FILA)) {
+    // Lo pendiente en iostream/stdio debe salir antes que este listado
+    std::cout.flush();
+    std::fflush(stdout);
+}
+
+Renderizador::~Renderizador() {
+    vaciar();
+}
+
+/**
+ * Implementación de vaciar.
+ *
+ * POR QUÉ: write(2) puede escribir menos de lo pedido o ser interrumpido.
+ * CÓMO: Repite hasta enviar todo; reintenta con EINTR. Ante otro error (disco lleno,
+ *       tubería cerrada...) guarda el errno y descarta el resto, también lo que llegue después.
+ * PARA QUÉ: Pocas llamadas al sistema por listado (una por búfer lleno) y un error que el
+ *           llamador puede consultar con correcto() en lugar de perderse.
+ */
+void Renderizador::vaciar() {
+    size_t enviados = 0;
+    while (enviados < usados && codigoError == 0) {
+        ssize_t escritos = write(descriptor, bufer.data() + enviados, usados - enviados);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            codigoError = errno;
+            break;
+        }
+        enviados += static_cast<size_t>(escritos);
+    }
+    usados = 0;
+}
+
+void Renderizador::reservar(size_t bytes) {
+    if (usados + bytes > bufer.size()) {
+        vaciar();
+    }
+}
+
+void Renderizador::texto(const char* datos, size_t longitud) {
+    // Textos más grandes que el búfer se envían por partes
+    while (longitud > 0) {
+        reservar(std::min(longitud, bufer.size()));
+        size_t parte = std::min(longitud, bufer.size() - usados);
+        std::memcpy(bufer.data() + usados, datos, parte);
+        usados += parte;
+        datos += parte;
+        longitud -= parte;
+    }
+}
+
+// Un double enorme en formato fijo (hasta ~310 caracteres) no cabe en lo reservado: to_chars
+// lo informa en ec y no escribe nada útil, así que se reintenta con más espacio
+template <typename Formatear>
+void Renderizador::numero(Formatear formatear) {
+    for (;;) {
+        std::to_chars_result resultado = formatear(bufer.data() + usados, bufer.data() + bufer.size());
+        if (resultado.ec == std::errc()) {
+            usados = static_cast<size_t>(resultado.ptr - bufer.data());
+            return;
+        }
+        if (usados > 0) {
+            vaciar();
+        } else {
+            bufer.resize(bufer.size() * 2);
+        }
+    }
+}
+
+void Renderizador::entero(uint64_t valor) {
+    reservar(20);
+    numero([valor](char* inicio, char* fin) { return std::to_chars(inicio, fin, valor); });
+}
+
+// Igual que std::fixed << std::setprecision(2)
+void Renderizador::decimal2(double valor) {
+    reservar(MAX_NUMEROS_FILA);
+    numero([valor](char* inicio, char* fin) { return std::to_chars(inicio, fin, valor, std::chars_format::fixed, 2); });
+}
+
+void Renderizador::resumen(size_t indice, const Persona& persona) {
+    entero(indice);
+    texto(". [", 3);
+    entero(persona.getId());
+    texto("] ", 2);
+    texto(persona.getNombre().data(), persona.getNombre().size());
+    texto(" ", 1);
+    texto(persona.getApellidoPaterno().data(), persona.getApellidoPaterno().size());
+    if (!persona.getApellidoMaterno().empty()) {
+        texto(" ", 1);
+        texto(persona.getApellidoMaterno().data(), persona.getApellidoMaterno().size());
+    }
+    texto(" | ", 3);
+    texto(persona.getCiudadNacimiento().data(), persona.getCiudadNacimiento().size());
+    texto(" | $", 4);
+    decimal2(persona.getIngresosAnuales());
+    texto(" | edad: ", 9);
+    int edad = persona.calcularEdad();
+    if (edad < 0) {
+        texto("-", 1);
+        edad = -edad;
+    }
+    entero(static_cast<uint64_t>(edad));
+    texto("\n", 1);
+}
+
+size_t Renderizador::listar(const ColeccionPersonas& personas, size_t desde, size_t hasta, uint64_t primerIndice) {
+    hasta = std::min(hasta, personas.size());
+    for (size_t i = desde; i < hasta; ++i) {
+        resumen(primerIndice + i, personas[i]);
+    }
+    return hasta > desde ? hasta - desde : 0;
+}
@@ -0,0 +1,71 @@
+#ifndef RENDERIZADOR_H
+#define RENDERIZADOR_H
+
+#include "persona.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Escritor de listados con búfer propio y formateo sin reservas de memoria.
+ *
+ * POR QUÉ: mostrarResumen hace unas diez inserciones de iostream por fila y reajusta
+ *          std::fixed/setprecision cada vez; listar un millón de filas domina la sesión.
+ * CÓMO: Cada fila se formatea con std::to_chars (enteros y doubles con 2 decimales) en un
+ *       búfer grande que se reutiliza y se vacía con pocas llamadas a write(2).
+ * PARA QUÉ: Listados completos o por rango con el mismo texto que mostrarResumen, limitados
+ *           por la velocidad de la salida y no por el formateo.
+ */
+class Renderizador {
+public:
+    // Capacidad por defecto del búfer: 1 MiB
+    static const size_t CAPACIDAD_POR_DEFECTO = 1 << 20;
+
+    explicit Renderizador(int descriptor = 1, size_t capacidad = CAPACIDAD_POR_DEFECTO);
+    ~Renderizador();
+
+    Renderizador(const Renderizador&) = delete;
+    Renderizador& operator=(const Renderizador&) = delete;
+
+    /**
+     * Escribe la línea "i. [id] nombre apellido | ciudad | $ingresos | edad: N".
+     *
+     * POR QUÉ: Es el formato de la opción 1 (índice + mostrarResumen).
+     * CÓMO: Copia de textos y to_chars directamente en el búfer.
+     * PARA QUÉ: Salida idéntica a la original, sin iostream.
+     */
+    void resumen(size_t indice, const Persona& persona);
+
+    /**
+     * Escribe las filas [desde, hasta) de la colección con resumen().
+     * @param primerIndice Índice mostrado para personas[0] (fila global de un lote).
+     * @return Número de filas escritas.
+     */
+    size_t listar(const ColeccionPersonas& personas, size_t desde, size_t hasta, uint64_t primerIndice = 0);
+
+    // Agrega texto literal al búfer
+    void texto(const char* datos, size_t longitud);
+
+    // Envía al descriptor lo acumulado en el búfer
+    void vaciar();
+
+    // false si alguna escritura falló (lo que quedaba se descartó); error() da el errno
+    bool correcto() const { return codigoError == 0; }
+    int error() const { return codigoError; }
+
+private:
+    // Garantiza espacio para 'bytes' más (vacía el búfer si hace falta)
+    void reservar(size_t bytes);
+    // Escribe con to_chars; si no cabe, vacía el búfer y, si tampoco cabe vacío, lo agranda
+    template <typename Formatear>
+    void numero(Formatear formatear);
+    void entero(uint64_t valor);
+    void decimal2(double valor);
+
+    int descriptor;
+    std::vector<char> bufer;
+    size_t usados = 0;
+    int codigoError = 0; // errno de la primera escritura fallida
+};
+
+#endif // RENDERIZADOR_H
@@ -0,0 +1,53 @@
+#include "tabla.h"
+#include <stdexcept> // std::length_error
+
+void TablaPersonas::preparar(size_t n, const std::vector<std::string>& nombresCiudad) {
+    if (nombresCiudad.size() > static_cast<size_t>(UINT8_MAX) + 1) {
+        throw std::length_error("TablaPersonas: demasiadas ciudades distintas para un código de 8 bits");
+    }
+    limpiar();
+    ingresos.resize(n);
+    patrimonio.resize(n);
+    deudas.resize(n);
+    fechaNacimiento.resize(n);
+    codigoCiudad.resize(n);
+    calendario.resize(n);
+    declarante.assign((n + 63) / 64, 0);
+    ciudades = nombresCiudad;
+}
+
+void TablaPersonas::asignar(size_t fila, const Persona& persona, uint8_t codigo) {
+    ingresos[fila] = persona.getIngresosAnuales();
+    patrimonio[fila] = persona.getPatrimonio();
+    deudas[fila] = persona.getDeudas();
+    fechaNacimiento[fila] = persona.getFechaEmpaquetada();
+    codigoCiudad[fila] = codigo;
+    calendario[fila] = static_cast<uint8_t>(persona.getCalendario() - 'A');
+    if (persona.getDeclaranteRenta()) {
+        declarante[fila >> 6] |= uint64_t(1) << (fila & 63);
+    }
+}
+
+void TablaPersonas::asignarValores(size_t fila, double valorIngresos, double valorPatrimonio, double valorDeudas,
+                                   int32_t fecha, uint8_t codigo, uint8_t grupo, bool esDeclarante) {
+    ingresos[fila] = valorIngresos;
+    patrimonio[fila] = valorPatrimonio;
+    deudas[fila] = valorDeudas;
+    fechaNacimiento[fila] = fecha;
+    codigoCiudad[fila] = codigo;
+    calendario[fila] = grupo;
+    if (esDeclarante) {
+        declarante[fila >> 6] |= uint64_t(1) << (fila & 63);
+    }
+}
+
+void TablaPersonas::limpiar() {
+    ingresos.clear();
+    patrimonio.clear();
+    deudas.clear();
+    fechaNacimiento.clear();
+    codigoCiudad.clear();
+    calendario.clear();
+    declarante.clear();
+    ciudades.clear();
+}
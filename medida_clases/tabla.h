@@ -0,0 +1,105 @@
+#ifndef TABLA_H
+#define TABLA_H
+
+#include "persona.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Vista de solo lectura sobre las columnas de una tabla de personas.
+ *
+ * POR QUÉ: Los recorridos analíticos solo necesitan punteros a arreglos contiguos, vengan de
+ *          una TablaPersonas o de cualquier otra fuente columnar.
+ * CÓMO: Un puntero por columna más el número de filas; no es dueña de la memoria.
+ * PARA QUÉ: Que el agregador de una sola pasada funcione sobre cualquier almacenamiento columnar.
+ */
+struct ColumnasPersonas {
+    size_t filas;
+    const double* ingresos;
+    const double* patrimonio;
+    const int32_t* fechaNacimiento; // AAAAMMDD
+    const uint8_t* codigoCiudad;
+    const uint8_t* calendario;      // 0=A, 1=B, 2=C
+    const uint64_t* declarante;     // Bitset, una palabra por cada 64 filas
+};
+
+/**
+ * Tabla columnar (struct-of-arrays) con los datos analíticos de las personas.
+ *
+ * POR QUÉ: Recorrer un std::vector<Persona> arrastra cinco strings y tres doubles por fila
+ *          a la caché aunque el análisis solo use un campo (p. ej. los ingresos).
+ * CÓMO: Guardando cada atributo en su propio arreglo contiguo (ingresos, patrimonio, deudas,
+ *       fecha de nacimiento empaquetada, código de ciudad, grupo de calendario y un bitset de declarantes).
+ *       La fila i de la tabla corresponde siempre a personas[i].
+ * PARA QUÉ: Que los rankings y agregaciones lean solo las columnas que necesitan y pasen de
+ *           estar limitados por memoria a estar limitados por cómputo.
+ */
+class TablaPersonas {
+public:
+    /**
+     * Deja la tabla con n filas vacías y un diccionario de ciudades fijo.
+     *
+     * POR QUÉ: Llenar columnas con push_back no se puede hacer desde varios hilos.
+     * CÓMO: Redimensiona todas las columnas (bitset en cero) y registra las ciudades en orden,
+     *       de modo que el código de una ciudad es su posición en 'ciudades'.
+     * PARA QUÉ: Llenar la tabla en paralelo con asignar().
+     */
+    void preparar(size_t n, const std::vector<std::string>& ciudades);
+
+    /**
+     * Escribe una persona en una fila ya existente.
+     *
+     * POR QUÉ: Llenado paralelo tras preparar().
+     * CÓMO: Copia los valores numéricos, la fecha empaquetada y el grupo de calendario del ID;
+     *       el código de ciudad ya viene resuelto.
+     * PARA QUÉ: Generación en paralelo. Hilos distintos pueden escribir a la vez si cada uno
+     *           usa tramos de filas alineados a 64 (el bitset guarda 64 filas por palabra).
+     */
+    void asignar(size_t fila, const Persona& persona, uint8_t codigoCiudad);
+
+    // Igual que asignar(), con los valores sueltos (para fuentes que no construyen una Persona)
+    void asignarValores(size_t fila, double ingresos, double patrimonio, double deudas, int32_t fecha,
+                        uint8_t codigoCiudad, uint8_t calendario, bool declarante);
+
+    // Elimina todas las filas y el diccionario de ciudades
+    void limpiar();
+
+    size_t tamano() const { return ingresos.size(); }
+    bool vacia() const { return ingresos.empty(); }
+
+    // Acceso de solo lectura a las columnas
+    const std::vector<double>& getIngresos() const { return ingresos; }
+    const std::vector<double>& getPatrimonio() const { return patrimonio; }
+    const std::vector<double>& getDeudas() const { return deudas; }
+    const std::vector<int32_t>& getFechaNacimiento() const { return fechaNacimiento; }
+    const std::vector<uint8_t>& getCodigoCiudad() const { return codigoCiudad; }
+    const std::vector<uint8_t>& getCalendario() const { return calendario; }
+    bool esDeclarante(size_t fila) const { return (declarante[fila >> 6] >> (fila & 63)) & 1u; }
+
+    // Vista de punteros a todas las columnas (válida mientras la tabla no cambie)
+    ColumnasPersonas columnas() const {
+        return ColumnasPersonas{ingresos.size(), ingresos.data(), patrimonio.data(), fechaNacimiento.data(),
+                                codigoCiudad.data(), calendario.data(), declarante.data()};
+    }
+
+    // Diccionario de ciudades: código -> nombre
+    size_t numCiudades() const { return ciudades.size(); }
+    const std::vector<std::string>& getCiudades() const { return ciudades; }
+    const std::string& nombreCiudad(uint8_t codigo) const { return ciudades[codigo]; }
+
+    // Letra del grupo de calendario (A/B/C) para un código 0/1/2
+    static char letraCalendario(uint8_t grupo) { return static_cast<char>('A' + grupo); }
+
+private:
+    std::vector<double> ingresos;         // Ingresos anuales
+    std::vector<double> patrimonio;       // Patrimonio total
+    std::vector<double> deudas;           // Deudas totales
+    std::vector<int32_t> fechaNacimiento; // Fecha de nacimiento AAAAMMDD
+    std::vector<uint8_t> codigoCiudad;    // Índice en 'ciudades'
+    std::vector<uint8_t> calendario;      // Grupo de calendario: 0=A, 1=B, 2=C
+    std::vector<uint64_t> declarante;     // Bitset: bit (i % 64) de la palabra i / 64
+    std::vector<std::string> ciudades;    // Diccionario de ciudades
+};
+
+#endif // TABLA_H
@@ -0,0 +1,45 @@
+#include "virtual.h"
+#include "generador.h"
+#include "monitor.h"   // TramoPerfil
+#include "tabla.h"
+#include <algorithm>   // std::min, std::max
+
+Persona ConjuntoVirtual::persona(uint64_t fila) const {
+    return generarPersona(semilla, fila);
+}
+
+uint64_t ConjuntoVirtual::filaDeID(uint64_t id) const {
+    return id >= ID_INICIAL && id - ID_INICIAL < filas ? id - ID_INICIAL : SIN_FILA;
+}
+
+bool ConjuntoVirtual::buscarPorID(uint64_t id, Persona& encontrada) const {
+    uint64_t fila = filaDeID(id);
+    if (fila == SIN_FILA) {
+        return false;
+    }
+    encontrada = persona(fila);
+    return true;
+}
+
+/**
+ * Implementación de agregar.
+ *
+ * POR QUÉ: El conjunto no existe en memoria; hay que producir sus columnas para recorrerlo.
+ * CÓMO: Lotes de filas consecutivas: generarFilasColumnas llena la tabla (en paralelo) y
+ *       AgregadorPorLotes la acumula cortando bloques en los mismos bordes que el recorrido
+ *       completo. Con lotes múltiplos de TAM_BLOQUE_AGREGADO cada lote es un número entero de bloques.
+ * PARA QUÉ: Rendimiento de la agregación a gran escala con memoria constante.
+ */
+ResultadoAgregado ConjuntoVirtual::agregar(size_t tamLote, PoolHilos& pool) const {
+    TramoPerfil tramo("agregar conjunto virtual");
+    tamLote = std::max<size_t>(1, (tamLote + TAM_BLOQUE_AGREGADO - 1) / TAM_BLOQUE_AGREGADO) * TAM_BLOQUE_AGREGADO;
+
+    AgregadorPorLotes agregador(ciudadesGenerador().size());
+    TablaPersonas tabla;
+    for (uint64_t inicio = 0; inicio < filas; inicio += tamLote) {
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(filas - inicio, tamLote));
+        generarFilasColumnas(inicio, n, semilla, tabla, pool);
+        agregador.agregar(tabla.columnas(), inicio);
+    }
+    return agregador.terminar();
+}
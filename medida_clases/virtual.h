@@ -0,0 +1,53 @@
+#ifndef VIRTUAL_H
+#define VIRTUAL_H
+
+#include "persona.h"
+#include "agregador.h"
+#include "hilos.h"
+#include <cstdint>
+
+/**
+ * Conjunto de datos virtual: la persona i se calcula cuando se pide, a partir de (semilla, i).
+ *
+ * POR QUÉ: Las pruebas de escala necesitan una población determinista, no personas guardadas;
+ *          mil millones de filas no caben en memoria ni como colección ni como tabla.
+ * CÓMO: Solo guarda n y la semilla. La persona i es generarPersona(semilla, i) (mismas
+ *       distribuciones que el generador) y su ID es ID_INICIAL + i, así que buscar por ID es
+ *       una resta. El análisis llena una tabla por lote con generarFilasColumnas y la pasa a
+ *       un AgregadorPorLotes.
+ * PARA QUÉ: Acceso por índice y por ID en O(1) de memoria y tiempo, y agregaciones sobre
+ *           10^9 filas con memoria acotada por el lote; mismos datos y mismo resultado que
+ *           generarColeccion(n, semilla) seguido de agregarEnUnaPasada.
+ */
+class ConjuntoVirtual {
+public:
+    ConjuntoVirtual(uint64_t n = 0, uint64_t semilla = 1) : filas(n), semilla(semilla) {}
+
+    uint64_t tamano() const { return filas; }
+    uint64_t getSemilla() const { return semilla; }
+
+    // Persona de una fila (fila < tamano())
+    Persona persona(uint64_t fila) const;
+
+    // Fila de un ID, o SIN_FILA si el ID no pertenece al conjunto
+    uint64_t filaDeID(uint64_t id) const;
+
+    // Busca por ID; true si existe (y deja la persona en 'persona')
+    bool buscarPorID(uint64_t id, Persona& persona) const;
+
+    /**
+     * Calcula todas las estadísticas del conjunto recorriéndolo por lotes.
+     *
+     * POR QUÉ: Medir el rendimiento de la agregación a escalas que no se pueden materializar.
+     * CÓMO: Una sola TablaPersonas de tamLote filas (redondeado a múltiplo de
+     *       TAM_BLOQUE_AGREGADO) se llena en paralelo para cada lote y se acumula en orden.
+     * PARA QUÉ: Resultado bit a bit igual al de agregarEnUnaPasada sobre el conjunto generado.
+     */
+    ResultadoAgregado agregar(size_t tamLote, PoolHilos& pool) const;
+
+private:
+    uint64_t filas;
+    uint64_t semilla;
+};
+
+#endif // VIRTUAL_H
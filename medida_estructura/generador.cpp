@@ -47,9 +47,9 @@ std::string generarFechaNacimiento() {
     return std::to_string(dia) + "/" + std::to_string(mes) + "/" + std::to_string(anio);
 }
 
-std::string generarID() {
-    static long contador = 1000000000; // ID inicial
-    return std::to_string(contador++); // Incrementa después de usar
+uint64_t generarID() {
+    static uint64_t contador = 1000000000; // ID inicial
+    return contador++;                     // Incrementa después de usar
 }
 
 double randomDouble(double min, double max) {
@@ -81,6 +81,8 @@ Persona generarPersona() {
     p.ciudadNacimiento = ciudadesColombia[rand() % ciudadesColombia.size()];
     // Fecha aleatoria
     p.fechaNacimiento = generarFechaNacimiento();
+    // Fecha empaquetada una sola vez para que calcularEdad sea aritmética pura
+    p.fechaEmpaquetada = empaquetarFecha(p.fechaNacimiento);
     
     // --- Generación de datos económicos realistas ---
     // Ingresos entre 10 millones y 500 millones COP
@@ -108,7 +110,7 @@ std::vector<Persona> generarColeccion(int n) {
     return personas;
 }
 
-const Persona* buscarPorID(const std::vector<Persona>& personas, const std::string& id) {
+const Persona* buscarPorID(const std::vector<Persona>& personas, uint64_t id) {
     // Búsqueda lineal por ID (solución simple para colecciones medianas)
     for (const auto& persona : personas) {
         if (persona.id == id) { // Acceso directo al campo id
@@ -116,4 +118,19 @@ const Persona* buscarPorID(const std::vector<Persona>& personas, const std::stri
         }
     }
     return nullptr; // Retorna nulo si no encuentra
-}
\ No newline at end of file
+}
+
+const Persona* buscarPorID(const std::vector<Persona>& personas, const std::string& id) {
+    // Convierte el texto una sola vez: solo dígitos, como máximo 19 (caben en 64 bits)
+    if (id.empty() || id.size() > 19) {
+        return nullptr;
+    }
+    uint64_t valor = 0;
+    for (char c : id) {
+        if (c < '0' || c > '9') {
+            return nullptr;
+        }
+        valor = valor * 10 + static_cast<uint64_t>(c - '0');
+    }
+    return buscarPorID(personas, valor);
+}
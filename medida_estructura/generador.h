@@ -10,7 +10,7 @@
 std::string generarFechaNacimiento();
 
 // Genera ID único secuencial
-std::string generarID();
+uint64_t generarID();
 
 // Genera número decimal en rango [min, max]
 double randomDouble(double min, double max);
@@ -23,6 +23,9 @@ std::vector<Persona> generarColeccion(int n);
 
 // Busca persona por ID en un vector
 // Retorna puntero a persona si la encuentra, nullptr si no
+const Persona* buscarPorID(const std::vector<Persona>& personas, uint64_t id);
+
+// Igual que la anterior con el ID en texto (leído de consola); nullptr si no es un número válido
 const Persona* buscarPorID(const std::vector<Persona>& personas, const std::string& id);
 
 #endif // GENERADOR_H
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <vector>
 #include <limits> // Para manejo de límites de entrada
 #include <memory> // Para std::unique_ptr y std::make_unique
+#include <chrono> // Para medir la compactación por separado
 #include "persona.h"
 #include "generador.h"
 #include "monitor.h" // Nuevo header para monitoreo
@@ -25,6 +26,10 @@ void mostrarMenu() {
     std::cout << "\n14. Persona mas longeva - [Valor]";
     std::cout << "\n15. Persona mas longeva - [Referencia]";
     std::cout << "\n16. Salir";
+    std::cout << "\n17. Persona mas longeva (compacta) - [Valor]";
+    std::cout << "\n18. Persona mas longeva (compacta) - [Referencia]";
+    std::cout << "\n19. Mayor patrimonio (compacta) -> [Valor]";
+    std::cout << "\n20. Mayor patrimonio (compacta) -> [Referencia]";
     std::cout << "\nSeleccione una opción: ";
 }
 
@@ -33,6 +38,8 @@ int main() {
     
     // Usar unique_ptr para manejar la colección de personas
     std::unique_ptr<std::vector<Persona>> personas = nullptr;
+    // Mismas personas como PersonaCompacta (POD de tamaño fijo) para las opciones 17-20
+    std::vector<PersonaCompacta> compactas;
     Monitor monitor;
     
     int opcion;
@@ -70,6 +77,17 @@ int main() {
                           << tiempo_gen << " ms, Memoria: " << memoria_gen << " KB\n";
                 
                 monitor.registrar("Crear datos", tiempo_gen, memoria_gen);
+
+                // La versión compacta se mide aparte (con su propio reloj: reiniciar el del monitor
+                // dejaría mal la estadística de la opción 0, que debe incluir ambos pasos)
+                auto inicio_compactar = std::chrono::steady_clock::now();
+                compactas = compactarColeccion(*personas);
+                std::chrono::duration<double, std::milli> duracion_compactar =
+                    std::chrono::steady_clock::now() - inicio_compactar;
+                double tiempo_compactar = duracion_compactar.count();
+                std::cout << "Versión compacta: " << sizeof(PersonaCompacta) << " bytes por persona (Persona: "
+                          << sizeof(Persona) << " más sus textos), " << tiempo_compactar << " ms\n";
+                monitor.registrar("Compactar datos", tiempo_compactar, 0);
                 break;
             }
                 
@@ -275,13 +293,69 @@ int main() {
                 promedioEdadPaisRef(*personas);
                 break;
             }
+
+            case 16: // Salir
+                break;
                 
+            case 17: { // Persona más longeva (compacta) - Por Valor
+                if (compactas.empty()) {
+                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                    break;
+                }
+                PersonaCompacta vieja = edadMasLongevaPaisCompacta(compactas);
+                vieja.mostrarResumen();
+                std::cout << "\nMas longeva por ciudad:\n";
+                std::vector<PersonaCompacta> viejaCiudad = edadMasLongevaCiudadCompacta(compactas);
+                for (const auto& persona : viejaCiudad) {
+                    persona.mostrarResumen();
+                    std::cout << "\n";
+                }
+                std::cout << "\nPromedio de edad en el país (valor):\n";
+                std::cout << promedioEdadPaisCompacta(compactas) << " años\n";
+                double tiempo_mostrar = monitor.detener_tiempo();
+                long memoria_mostrar = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Mas longeva compacta Valor", tiempo_mostrar, memoria_mostrar);
+                break;
+            }
+
+            case 18: { // Persona más longeva (compacta) - Por Referencia
+                if (compactas.empty()) {
+                    std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+                    break;
+                }
+                std::cout << "\nUsando referencias:\n";
+                std::cout << "La persona más longeva es ";
+                edadMasLongevaPaisCompactaRef(compactas).mostrarResumen();
+                std::cout << "\nUsando referencias por ciudad:\n";
+                std::vector<const PersonaCompacta*> viejaCiudad;
+                edadMasLongevaCiudadCompactaRef(compactas, viejaCiudad);
+                for (const PersonaCompacta* persona : viejaCiudad) {
+                    persona->mostrarResumen();
+                    std::cout << "\n";
+                }
+                std::cout << "\nPromedio de edad en el país (referencia):\n";
+                std::cout << promedioEdadPaisCompactaRef(compactas) << "\n";
+                double tiempo_mostrar = monitor.detener_tiempo();
+                long memoria_mostrar = monitor.obtener_memoria() - memoria_inicio;
+                monitor.registrar("Mas longeva compacta Referencia", tiempo_mostrar, memoria_mostrar);
+                break;
+            }
+
+            case 19: // Mayor patrimonio (compacta) - Por Valor
+                mostrarMayorPatrimonioCompacta(compactas);
+                break;
+
+            case 20: // Mayor patrimonio (compacta) - Por Referencia
+                mostrarMayorPatrimonioCompactaRef(compactas);
+                break;
+
+
             default:
                 std::cout << "Opción inválida!\n";
         }
         
         // Mostrar estadísticas para las operaciones principales
-        if (opcion >= 0 && opcion <= 15) {
+        if (opcion >= 0 && opcion <= 20 && opcion != 16) {
             double tiempo = monitor.detener_tiempo();
             long memoria = monitor.obtener_memoria() - memoria_inicio;
             monitor.mostrar_estadistica("Opción " + std::to_string(opcion), tiempo, memoria);
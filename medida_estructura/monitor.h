@@ -16,13 +16,13 @@ class Monitor {
 public:
     // Inicia la medición de tiempo
     void iniciar_tiempo() {
-        inicio = std::chrono::high_resolution_clock::now();
+        inicio = std::chrono::steady_clock::now();
     }
     
-    // Detiene la medición de tiempo y devuelve milisegundos
+    // Detiene la medición de tiempo y devuelve milisegundos con decimales (sin truncar)
     double detener_tiempo() {
-        auto fin = std::chrono::high_resolution_clock::now();
-        return std::chrono::duration_cast<std::chrono::milliseconds>(fin - inicio).count();
+        auto fin = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(fin - inicio).count();
     }
     
     // Obtiene el consumo de memoria actual en KB usando /proc/self/statm
@@ -97,7 +97,7 @@ private:
         long memoria;
     };
     
-    std::chrono::high_resolution_clock::time_point inicio;
+    std::chrono::steady_clock::time_point inicio; // Reloj monótono
     std::vector<Registro> registros;
     double total_tiempo = 0;
     long max_memoria = 0;
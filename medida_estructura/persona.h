@@ -8,15 +8,88 @@
 #include <map>
 #include <algorithm>
 #include <memory>
+#include <ctime>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+// Con -DESPACIO_VARIANTE=estructura todo queda en ese namespace (comparacion/ enlaza esta
+// variante junto a medida_clases, que usa los mismos nombres); sin la macro no cambia nada
+#ifdef ESPACIO_VARIANTE
+namespace ESPACIO_VARIANTE {
+#endif
+
+// --- Calendario (A/B/C) por terminación del ID ---
+
+// Letras de grupo para las terminaciones 00-99, calculadas en tiempo de compilación
+struct TablaCalendario {
+    char grupo[100];
+};
+
+constexpr TablaCalendario construirTablaCalendario() {
+    TablaCalendario tabla{};
+    for (int i = 0; i < 100; ++i) {
+        tabla.grupo[i] = i <= 39 ? 'A' : (i <= 79 ? 'B' : 'C');
+    }
+    return tabla;
+}
+
+constexpr TablaCalendario TABLA_CALENDARIO = construirTablaCalendario();
+
+// Clave del grupo de calendario de un ID: "A" (00-39), "B" (40-79) o "C" (80-99)
+inline const std::string& claveCalendario(uint64_t id) {
+    static const std::string claves[3] = {"A", "B", "C"};
+    return claves[TABLA_CALENDARIO.grupo[id % 100] - 'A'];
+}
+
+// --- Fechas empaquetadas (AAAAMMDD) ---
+
+// Empaqueta día, mes y año en un entero AAAAMMDD comparable con <
+inline int empaquetarFecha(int dia, int mes, int anio) {
+    return anio * 10000 + mes * 100 + dia;
+}
+
+// Convierte "D/M/AAAA" en AAAAMMDD recorriendo los dígitos (sin substr ni stoi); 0 si es inválida
+inline int empaquetarFecha(const std::string& fecha) {
+    int campos[3] = {0, 0, 0}; // día, mes, año
+    int campo = 0;
+    for (char c : fecha) {
+        if (c == '/') {
+            if (++campo > 2) return 0;
+        } else if (c >= '0' && c <= '9') {
+            campos[campo] = campos[campo] * 10 + (c - '0');
+        } else {
+            return 0;
+        }
+    }
+    return campo == 2 ? empaquetarFecha(campos[0], campos[1], campos[2]) : 0;
+}
+
+// Fecha de referencia (AAAAMMDD) para las edades; por defecto, la fecha de hoy
+inline int& fechaReferencia() {
+    static int referencia = [] {
+        std::time_t ahora = std::time(nullptr);
+        std::tm* local = std::localtime(&ahora);
+        return empaquetarFecha(local->tm_mday, local->tm_mon + 1, local->tm_year + 1900);
+    }();
+    return referencia;
+}
+
+// Cambia la fecha contra la que se calculan las edades
+inline void establecerFechaReferencia(int dia, int mes, int anio) {
+    fechaReferencia() = empaquetarFecha(dia, mes, anio);
+}
 
 // Estructura que representa una persona con datos personales y fiscales
 struct Persona {
     // Datos básicos de identificación
     std::string nombre;           // Nombre de pila
     std::string apellido;         // Apellidos
-    std::string id;               // Identificador único
+    uint64_t id;                  // Identificador único (numérico; texto solo al mostrarlo)
     std::string ciudadNacimiento; // Ciudad de nacimiento en Colombia
     std::string fechaNacimiento;  // Fecha en formato DD/MM/AAAA
+    int fechaEmpaquetada;         // Misma fecha como AAAAMMDD (la llena generarPersona)
     
     // Datos fiscales y económicos
     double ingresosAnuales;       // Ingresos anuales en pesos colombianos
@@ -65,15 +138,10 @@ inline void agruparCiudadRef(const std::vector<Persona>& personas, std::map<std:
     }
 }
 
+// Años cumplidos a la fecha de referencia: con fechas AAAAMMDD basta una resta y una división
 inline int Persona::calcularEdad() const {
-        size_t pos = fechaNacimiento.find_last_of("/");
-        std::string anio = fechaNacimiento.substr(pos + 1);
-
-        int anioNacimiento = std::stoi(anio);
-        int anioActual = 2025; // Año actual
-
-        return anioActual - anioNacimiento;
-    }
+    return (fechaReferencia() - fechaEmpaquetada) / 10000;
+}
 
 //promedio de edades - por valor
 inline double promedioEdadPais(const std::vector<Persona> personas) {
@@ -120,7 +188,7 @@ inline void edadMasLongevaCiudadRef(const std::vector<Persona>& personas) {
         const Persona* pMasLongeva = &personasCiudad[0];
 
         for (const Persona& personaActual : personasCiudad) {
-            if (personaActual.calcularEdad() > pMasLongeva->calcularEdad()) {
+            if (personaActual.fechaEmpaquetada < pMasLongeva->fechaEmpaquetada) {
                 pMasLongeva = &personaActual;
             }
         }
@@ -148,7 +216,7 @@ inline std::vector<Persona> edadMasLongevaCiudad(const std::vector<Persona> pers
         Persona masLongeva = personasCiudad[0];
 
         for (size_t i = 1; i < personasCiudad.size(); ++i) {
-            if (personasCiudad[i].calcularEdad() > masLongeva.calcularEdad()) {
+            if (personasCiudad[i].fechaEmpaquetada < masLongeva.fechaEmpaquetada) {
                 masLongeva = personasCiudad[i];
             }
         }
@@ -162,7 +230,7 @@ inline void edadMasLongevaPaisRef(const std::vector<Persona>& personas){
     const Persona* pPersonaMasVieja = &personas[0];
 
     for (const Persona& personaActual : personas) {
-        if (personaActual.calcularEdad() > pPersonaMasVieja->calcularEdad()) {
+        if (personaActual.fechaEmpaquetada < pPersonaMasVieja->fechaEmpaquetada) {
                         pPersonaMasVieja = &personaActual;
         }
     }
@@ -175,7 +243,7 @@ inline void edadMasLongevaPaisRef(const std::vector<Persona>& personas){
 inline Persona edadMasLongevaPais(const std::vector<Persona> personas){
     Persona vieja = personas[0];
     for (size_t i = 1; i < personas.size(); ++i) {
-        if (personas[i].calcularEdad() > vieja.calcularEdad()) {
+        if (personas[i].fechaEmpaquetada < vieja.fechaEmpaquetada) {
             vieja = personas[i];
         }
     }
@@ -186,15 +254,7 @@ inline Persona edadMasLongevaPais(const std::vector<Persona> personas){
 inline std::map<std::string, std::vector<Persona>> agruparCalendario(const std::vector<Persona> personas){
     std::map<std::string, std::vector<Persona>> calendario;
     for (const Persona& persona : personas){
-        std::string ultimosDos = (persona.id).substr((persona.id).length() - 2, 2);
-        int ultimosDosInt = std::stoi(ultimosDos);
-        if (ultimosDosInt >= 0 && ultimosDosInt <= 39){
-            calendario["A"].push_back(persona);
-        } else if (ultimosDosInt >= 40 && ultimosDosInt <= 79){
-            calendario["B"].push_back(persona);
-        } else if (ultimosDosInt >= 80 && ultimosDosInt <= 99){
-            calendario["C"].push_back(persona); 
-        }
+        calendario[claveCalendario(persona.id)].push_back(persona);
     }
     return calendario;
 }
@@ -202,15 +262,7 @@ inline std::map<std::string, std::vector<Persona>> agruparCalendario(const std::
 // Agrupar por calendario - Por Referencia
 inline void agruparCalendarioRef(const std::vector<Persona>& personas, std::map<std::string, std::vector<Persona>>& calendario){
     for (const Persona& persona : personas){
-        std::string ultimosDos = (persona.id).substr((persona.id).length() - 2, 2);
-        int ultimosDosInt = std::stoi(ultimosDos);
-        if (ultimosDosInt >= 0 && ultimosDosInt <= 39){
-            calendario["A"].push_back(persona);
-        } else if (ultimosDosInt >= 40 && ultimosDosInt <= 79){
-            calendario["B"].push_back(persona);
-        } else if (ultimosDosInt >= 80 && ultimosDosInt <= 99){
-            calendario["C"].push_back(persona); 
-        }
+        calendario[claveCalendario(persona.id)].push_back(persona);
     }
 }
 
@@ -449,4 +501,331 @@ inline void mostrarMayorPatrimonioPorReferencia(std::unique_ptr<std::vector<Pers
     }
 }
 
-#endif // PERSONA_H
\ No newline at end of file
+// --- Registro compacto (POD de tamaño fijo) ---
+
+// Textos de los códigos de PersonaCompacta; el código 0 es siempre el texto vacío
+class TablaTextos {
+public:
+    explicit TablaTextos(size_t limite = 65536) : limite(limite), textos(1) {}
+
+    // Código del texto (lo agrega si es nuevo); con la tabla llena lanza std::length_error
+    // (devolver un código cualquiera mezclaría textos distintos sin que nadie lo note)
+    uint16_t codificar(const std::string& texto) {
+        auto it = codigos.find(texto);
+        if (it != codigos.end()) {
+            return it->second;
+        }
+        if (textos.size() >= limite) {
+            throw std::length_error("TablaTextos: más de " + std::to_string(limite) + " textos distintos");
+        }
+        uint16_t codigo = static_cast<uint16_t>(textos.size());
+        textos.push_back(texto);
+        codigos.emplace(texto, codigo);
+        return codigo;
+    }
+
+    const std::string& texto(uint16_t codigo) const { return textos[codigo]; }
+
+private:
+    size_t limite;
+    std::vector<std::string> textos;
+    std::unordered_map<std::string, uint16_t> codigos;
+};
+
+inline TablaTextos& textosNombres() {
+    static TablaTextos tabla;
+    return tabla;
+}
+
+inline TablaTextos& textosApellidos() {
+    static TablaTextos tabla;
+    return tabla;
+}
+
+inline TablaTextos& textosCiudades() {
+    static TablaTextos tabla(256); // El código de ciudad ocupa un byte
+    return tabla;
+}
+
+// Persona sin std::string: los textos son códigos de las tablas anteriores y la fecha va
+// empaquetada, así que copiarla es un memcpy de 48 bytes (cabe en una línea de caché)
+struct PersonaCompacta {
+    uint64_t id;
+    double ingresosAnuales;
+    double patrimonio;
+    double deudas;
+    int32_t fechaEmpaquetada;       // AAAAMMDD
+    uint16_t codigoNombre;
+    uint16_t codigoApellidoPaterno;
+    uint16_t codigoApellidoMaterno;
+    uint8_t codigoCiudad;
+    bool declaranteRenta;
+
+    const std::string& nombre() const { return textosNombres().texto(codigoNombre); }
+    const std::string& ciudadNacimiento() const { return textosCiudades().texto(codigoCiudad); }
+    std::string apellido() const;   // "Paterno Materno", como en Persona
+    std::string fechaNacimiento() const; // "D/M/AAAA", como la genera generarFechaNacimiento
+
+    void mostrar() const;
+    void mostrarResumen() const;
+    int calcularEdad() const { return (fechaReferencia() - fechaEmpaquetada) / 10000; }
+};
+
+static_assert(std::is_trivially_copyable<PersonaCompacta>::value, "PersonaCompacta debe copiarse con memcpy");
+static_assert(sizeof(PersonaCompacta) <= 64, "PersonaCompacta debe caber en una línea de caché");
+
+inline std::string PersonaCompacta::apellido() const {
+    const std::string& paterno = textosApellidos().texto(codigoApellidoPaterno);
+    const std::string& materno = textosApellidos().texto(codigoApellidoMaterno);
+    return materno.empty() ? paterno : paterno + " " + materno;
+}
+
+inline std::string PersonaCompacta::fechaNacimiento() const {
+    return std::to_string(fechaEmpaquetada % 100) + "/" + std::to_string(fechaEmpaquetada / 100 % 100) + "/" +
+           std::to_string(fechaEmpaquetada / 10000);
+}
+
+inline void PersonaCompacta::mostrar() const {
+    std::cout << "-------------------------------------\n";
+    std::cout << "[" << id << "] Nombre: " << nombre() << " " << apellido() << "\n";
+    std::cout << "   - Ciudad de nacimiento: " << ciudadNacimiento() << "\n";
+    std::cout << "   - Fecha de nacimiento: " << fechaNacimiento() << "\n\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "   - Ingresos anuales: $" << ingresosAnuales << "\n";
+    std::cout << "   - Patrimonio: $" << patrimonio << "\n";
+    std::cout << "   - Deudas: $" << deudas << "\n";
+    std::cout << "   - Declarante de renta: " << (declaranteRenta ? "Sí" : "No") << "\n";
+}
+
+inline void PersonaCompacta::mostrarResumen() const {
+    std::cout << "[" << id << "] " << nombre() << " " << apellido()
+              << " | " << ciudadNacimiento()
+              << " | $" << std::fixed << std::setprecision(2) << ingresosAnuales;
+}
+
+// Versión compacta de una Persona (el apellido se parte en el primer espacio)
+inline PersonaCompacta compactar(const Persona& persona) {
+    PersonaCompacta c;
+    c.id = persona.id;
+    c.ingresosAnuales = persona.ingresosAnuales;
+    c.patrimonio = persona.patrimonio;
+    c.deudas = persona.deudas;
+    c.fechaEmpaquetada = persona.fechaEmpaquetada;
+    c.codigoNombre = textosNombres().codificar(persona.nombre);
+    size_t espacio = persona.apellido.find(' ');
+    if (espacio == std::string::npos) {
+        c.codigoApellidoPaterno = textosApellidos().codificar(persona.apellido);
+        c.codigoApellidoMaterno = 0;
+    } else {
+        c.codigoApellidoPaterno = textosApellidos().codificar(persona.apellido.substr(0, espacio));
+        c.codigoApellidoMaterno = textosApellidos().codificar(persona.apellido.substr(espacio + 1));
+    }
+    c.codigoCiudad = static_cast<uint8_t>(textosCiudades().codificar(persona.ciudadNacimiento));
+    c.declaranteRenta = persona.declaranteRenta;
+    return c;
+}
+
+// Colección compacta con las mismas personas en el mismo orden
+inline std::vector<PersonaCompacta> compactarColeccion(const std::vector<Persona>& personas) {
+    std::vector<PersonaCompacta> compactas;
+    compactas.reserve(personas.size());
+    for (const Persona& persona : personas) {
+        compactas.push_back(compactar(persona));
+    }
+    return compactas;
+}
+
+// Agrupar por ciudad (compacta) - Por Valor
+inline std::map<std::string, std::vector<PersonaCompacta>> agruparCiudadCompacta(const std::vector<PersonaCompacta> personas) {
+    std::map<std::string, std::vector<PersonaCompacta>> ciudad;
+    for (const PersonaCompacta& persona : personas) {
+        ciudad[persona.ciudadNacimiento()].push_back(persona);
+    }
+    return ciudad;
+}
+
+// Agrupar por ciudad (compacta) - Por Referencia
+inline void agruparCiudadCompactaRef(const std::vector<PersonaCompacta>& personas, std::map<std::string, std::vector<PersonaCompacta>>& ciudad) {
+    for (const PersonaCompacta& persona : personas) {
+        ciudad[persona.ciudadNacimiento()].push_back(persona);
+    }
+}
+
+// Agrupar por calendario (compacta) - Por Valor
+inline std::map<std::string, std::vector<PersonaCompacta>> agruparCalendarioCompacta(const std::vector<PersonaCompacta> personas) {
+    std::map<std::string, std::vector<PersonaCompacta>> calendario;
+    for (const PersonaCompacta& persona : personas) {
+        calendario[claveCalendario(persona.id)].push_back(persona);
+    }
+    return calendario;
+}
+
+// Agrupar por calendario (compacta) - Por Referencia
+inline void agruparCalendarioCompactaRef(const std::vector<PersonaCompacta>& personas, std::map<std::string, std::vector<PersonaCompacta>>& calendario) {
+    for (const PersonaCompacta& persona : personas) {
+        calendario[claveCalendario(persona.id)].push_back(persona);
+    }
+}
+
+// Promedio de edades (compacta) - Por Valor
+inline double promedioEdadPaisCompacta(const std::vector<PersonaCompacta> personas) {
+    if (personas.empty()) {
+        return 0.0;
+    }
+    long long sumaEdades = 0;
+    for (const PersonaCompacta& persona : personas) {
+        sumaEdades += persona.calcularEdad();
+    }
+    return static_cast<double>(sumaEdades) / personas.size();
+}
+
+// Promedio de edades (compacta) - Por Referencia
+inline double promedioEdadPaisCompactaRef(const std::vector<PersonaCompacta>& personas) {
+    if (personas.empty()) {
+        return 0.0;
+    }
+    long long sumaEdades = 0;
+    for (const PersonaCompacta& persona : personas) {
+        sumaEdades += persona.calcularEdad();
+    }
+    return static_cast<double>(sumaEdades) / personas.size();
+}
+
+// Persona más longeva del país (compacta) - Por Valor
+inline PersonaCompacta edadMasLongevaPaisCompacta(const std::vector<PersonaCompacta> personas) {
+    PersonaCompacta vieja = personas[0];
+    for (size_t i = 1; i < personas.size(); ++i) {
+        if (personas[i].fechaEmpaquetada < vieja.fechaEmpaquetada) {
+            vieja = personas[i];
+        }
+    }
+    return vieja;
+}
+
+// Persona más longeva del país (compacta) - Por Referencia
+inline const PersonaCompacta& edadMasLongevaPaisCompactaRef(const std::vector<PersonaCompacta>& personas) {
+    const PersonaCompacta* vieja = &personas[0];
+    for (const PersonaCompacta& persona : personas) {
+        if (persona.fechaEmpaquetada < vieja->fechaEmpaquetada) {
+            vieja = &persona;
+        }
+    }
+    return *vieja;
+}
+
+// Persona más longeva por ciudad (compacta) - Por Valor
+inline std::vector<PersonaCompacta> edadMasLongevaCiudadCompacta(const std::vector<PersonaCompacta> personas) {
+    std::vector<PersonaCompacta> resultado;
+    for (const auto& par : agruparCiudadCompacta(personas)) {
+        resultado.push_back(edadMasLongevaPaisCompacta(par.second));
+    }
+    return resultado;
+}
+
+// Persona más longeva por ciudad (compacta) - Por Referencia
+inline void edadMasLongevaCiudadCompactaRef(const std::vector<PersonaCompacta>& personas, std::vector<const PersonaCompacta*>& resultado) {
+    std::map<std::string, std::vector<const PersonaCompacta*>> ciudad;
+    for (const PersonaCompacta& persona : personas) {
+        ciudad[persona.ciudadNacimiento()].push_back(&persona);
+    }
+    for (const auto& par : ciudad) {
+        const PersonaCompacta* vieja = par.second[0];
+        for (const PersonaCompacta* persona : par.second) {
+            if (persona->fechaEmpaquetada < vieja->fechaEmpaquetada) {
+                vieja = persona;
+            }
+        }
+        resultado.push_back(vieja);
+    }
+}
+
+// Persona con mayor patrimonio de cada grupo: cada cambio de candidata copia 48 bytes (un
+// memcpy dentro de una línea de caché, sin reservas de heap como las copias de Persona)
+inline void mostrarMasRicaPorGrupo(const std::map<std::string, std::vector<PersonaCompacta>>& grupos, const std::string& prefijo) {
+    for (const auto& par : grupos) {
+        if (par.second.empty()) continue;
+        PersonaCompacta masRica = par.second[0];
+        for (size_t i = 1; i < par.second.size(); ++i) {
+            if (par.second[i].patrimonio > masRica.patrimonio) {
+                masRica = par.second[i];
+            }
+        }
+        std::cout << prefijo << par.first << ": la persona con mayor patrimonio es ";
+        masRica.mostrarResumen();
+        std::cout << " con patrimonio: $" << masRica.patrimonio << "\n";
+    }
+}
+
+// Submenú de patrimonio (compartido por las dos versiones compactas); 0 si la opción es inválida
+inline int leerSubopcionPatrimonio() {
+    std::cout << "\n--- Menú Patrimonio ---\n";
+    std::cout << "1. Mayor patrimonio en el país\n";
+    std::cout << "2. Mayor patrimonio por ciudad\n";
+    std::cout << "3. Mayor patrimonio por grupo (A/B/C)\n";
+    int subop;
+    std::cout << "\nSeleccione una opción: ";
+    std::cin >> subop;
+    return subop >= 1 && subop <= 3 ? subop : 0;
+}
+
+// Mayor patrimonio (compacta) - Por Valor
+inline void mostrarMayorPatrimonioCompacta(std::vector<PersonaCompacta> personas) {
+    if (personas.empty()) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return;
+    }
+    int subop = leerSubopcionPatrimonio();
+    if (subop == 1) {
+        PersonaCompacta mayor = personas[0];
+        for (const auto& p : personas) {
+            if (p.patrimonio > mayor.patrimonio) {
+                mayor = p;
+            }
+        }
+        std::cout << "Persona con mayor patrimonio en el país:\n";
+        mayor.mostrarResumen();
+        std::cout << " Patrimonio: " << mayor.patrimonio << "\n";
+    } else if (subop == 2) {
+        std::cout << "\n--- Persona con mayor patrimonio por ciudad ---\n";
+        mostrarMasRicaPorGrupo(agruparCiudadCompacta(personas), "");
+    } else if (subop == 3) {
+        std::cout << "\n--- Persona con mayor patrimonio por grupo ---\n";
+        mostrarMasRicaPorGrupo(agruparCalendarioCompacta(personas), "Grupo ");
+    }
+}
+
+// Mayor patrimonio (compacta) - Por Referencia
+inline void mostrarMayorPatrimonioCompactaRef(const std::vector<PersonaCompacta>& personas) {
+    if (personas.empty()) {
+        std::cout << "\nNo hay datos disponibles. Use opción 0 primero.\n";
+        return;
+    }
+    int subop = leerSubopcionPatrimonio();
+    if (subop == 1) {
+        const PersonaCompacta* mayor = &personas[0];
+        for (const auto& p : personas) {
+            if (p.patrimonio > mayor->patrimonio) {
+                mayor = &p;
+            }
+        }
+        std::cout << "Persona con mayor patrimonio en el país:\n";
+        mayor->mostrarResumen();
+        std::cout << " Patrimonio: " << mayor->patrimonio << "\n";
+    } else if (subop == 2) {
+        std::map<std::string, std::vector<PersonaCompacta>> gruposCiudad;
+        agruparCiudadCompactaRef(personas, gruposCiudad);
+        std::cout << "\n--- Persona con mayor patrimonio por ciudad ---\n";
+        mostrarMasRicaPorGrupo(gruposCiudad, "");
+    } else if (subop == 3) {
+        std::map<std::string, std::vector<PersonaCompacta>> gruposPorCalendario;
+        agruparCalendarioCompactaRef(personas, gruposPorCalendario);
+        std::cout << "\n--- Persona con mayor patrimonio por grupo ---\n";
+        mostrarMasRicaPorGrupo(gruposPorCalendario, "Grupo ");
+    }
+}
+
+#ifdef ESPACIO_VARIANTE
+} // namespace ESPACIO_VARIANTE
+#endif
+
+#endif // PERSONA_H